@@ -109,6 +109,16 @@ class execute( Gaffer.Application ) :
 					},
 				),
 
+				IECore.FileNameParameter(
+					name = "traceFile",
+					description = "Turns on a trace monitor, and writes a timeline of all "
+						"processes to the specified file in Chrome Trace Event format. "
+						"This can be viewed using chrome://tracing or https://ui.perfetto.dev.",
+					defaultValue = "",
+					allowEmptyString = True,
+					extensions = "json",
+				),
+
 			]
 
 		)
@@ -163,23 +173,32 @@ class execute( Gaffer.Application ) :
 		if not frames :
 			frames = [ scriptNode.context().getFrame() ]
 
-		with context :
-			for node in nodes :
-				errorConnection = node.errorSignal().connect( Gaffer.WeakMethod( self.__error ) )
-				try :
-					node["task"].executeSequence( frames )
-				except Exception as exception :
-					IECore.msg(
-						IECore.Msg.Level.Debug,
-						"gaffer execute : executing %s" % node.relativeName( scriptNode ),
-						"".join( traceback.format_exception( *sys.exc_info() ) ),
-					)
-					IECore.msg(
-						IECore.Msg.Level.Error,
-						"gaffer execute : executing %s" % node.relativeName( scriptNode ),
-						"See previous message for details",
-					)
-					return 1
+		traceMonitor = Gaffer.TraceMonitor() if args["traceFile"].value else None
+		try :
+			with context, traceMonitor or _NullContextManager() :
+				return self.__execute( scriptNode, nodes, frames )
+		finally :
+			if traceMonitor is not None :
+				traceMonitor.writeTrace( args["traceFile"].value )
+
+	def __execute( self, scriptNode, nodes, frames ) :
+
+		for node in nodes :
+			errorConnection = node.errorSignal().connect( Gaffer.WeakMethod( self.__error ) )
+			try :
+				node["task"].executeSequence( frames )
+			except Exception as exception :
+				IECore.msg(
+					IECore.Msg.Level.Debug,
+					"gaffer execute : executing %s" % node.relativeName( scriptNode ),
+					"".join( traceback.format_exception( *sys.exc_info() ) ),
+				)
+				IECore.msg(
+					IECore.Msg.Level.Error,
+					"gaffer execute : executing %s" % node.relativeName( scriptNode ),
+					"See previous message for details",
+				)
+				return 1
 
 		return 0
 
@@ -191,5 +210,15 @@ class execute( Gaffer.Application ) :
 			message
 		)
 
+class _NullContextManager( object ) :
+
+	def __enter__( self ) :
+
+		pass
+
+	def __exit__( self, type, value, traceBack ) :
+
+		pass
+
 IECore.registerRunTimeTyped( execute )
 
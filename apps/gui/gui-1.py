@@ -70,6 +70,19 @@ class gui( Gaffer.Application ) :
 					description = "Opens the UI in full screen mode.",
 					defaultValue = False,
 				),
+
+				IECore.FileNameParameter(
+					name = "traceFile",
+					description = "Turns on a trace monitor, and writes a timeline of the "
+						"processes launched from the UI thread to the specified file in "
+						"Chrome Trace Event format when the application exits. This can "
+						"be viewed using chrome://tracing or https://ui.perfetto.dev. "
+						"Note that background tasks, such as the Viewer's scene updates, "
+						"are not included.",
+					defaultValue = "",
+					allowEmptyString = True,
+					extensions = "json",
+				),
 			]
 
 		)
@@ -90,7 +103,18 @@ class gui( Gaffer.Application ) :
 		# because `FileMenu.addScript()` may launch
 		# interactive dialogues.
 		GafferUI.EventLoop.addIdleCallback( functools.partial( self.__addScripts, args ) )
-		GafferUI.EventLoop.mainEventLoop().start()
+
+		if args["traceFile"].value :
+			# This captures the computes performed on the UI thread, and
+			# the TBB tasks they spawn. It does not capture work done by
+			# BackgroundTasks, such as the Viewer's scene updates, because
+			# they run with a default ThreadState and don't inherit
+			# monitors from the thread that launched them.
+			with Gaffer.TraceMonitor() as traceMonitor :
+				GafferUI.EventLoop.mainEventLoop().start()
+			traceMonitor.writeTrace( args["traceFile"].value )
+		else :
+			GafferUI.EventLoop.mainEventLoop().start()
 
 		return 0
 
@@ -76,6 +76,21 @@ class stats( Gaffer.Application ) :
 			```
 			gaffer stats fileName.gfr -image NameOfNode -performanceMonitor
 			```
+
+			To write a timeline of the processes performed on each thread, for
+			viewing in chrome://tracing or https://ui.perfetto.dev :
+
+			```
+			gaffer stats fileName.gfr -scene NameOfNode -traceFile trace.json
+			```
+
+			To find the serial sections and critical path that limit scaling,
+			comparing the results for several thread counts :
+
+			```
+			gaffer stats fileName.gfr -scene NameOfNode -parallelism -threads 8
+			gaffer stats fileName.gfr -scene NameOfNode -parallelism -threads 32
+			```
 			"""
 		)
 
@@ -192,6 +207,27 @@ class stats( Gaffer.Application ) :
 					defaultValue = False,
 				),
 
+				IECore.FileNameParameter(
+					name = "traceFile",
+					description = "Turns on a trace monitor, and writes a timeline of all "
+						"processes to the specified file in Chrome Trace Event format. "
+						"This can be viewed using chrome://tracing or https://ui.perfetto.dev.",
+					defaultValue = "",
+					allowEmptyString = True,
+					extensions = "json",
+				),
+
+				IECore.BoolParameter(
+					name = "parallelism",
+					description = "Turns on a trace monitor, and uses it to report the "
+						"average parallelism achieved, the time spent with only a "
+						"single thread busy, and an estimate of the critical path. "
+						"The nodes responsible for serial sections and for the critical "
+						"path are listed, as these limit scaling as the number of "
+						"threads increases.",
+					defaultValue = False,
+				),
+
 				IECore.BoolParameter(
 					name = "contextSanitiser",
 					description = "Checks for contexts containing \"leaked\" variables that "
@@ -216,6 +252,13 @@ class stats( Gaffer.Application ) :
 					defaultValue = 0,
 				),
 
+				IECore.BoolParameter(
+					name = "cache",
+					description = "Turns on collection of cache statistics, reporting hits, "
+						"misses, evictions and memory usage per node type and plug type.",
+					defaultValue = False,
+				),
+
 				IECore.IntParameter(
 					name = "hashCacheSizeLimit",
 					description = "The size limit for the per-thread hash cache. If this is not "
@@ -241,6 +284,9 @@ class stats( Gaffer.Application ) :
 		if args["hashCacheSizeLimit"].value :
 			Gaffer.ValuePlug.setHashCacheSizeLimit( args["hashCacheSizeLimit"].value )
 
+		if args["cache"].value :
+			Gaffer.ValuePlug.setCacheStatisticsEnabled( True )
+
 		self.__timers = collections.OrderedDict()
 		self.__memory = collections.OrderedDict()
 
@@ -273,13 +319,18 @@ class stats( Gaffer.Application ) :
 		else :
 			self.__contextMonitor = None
 
+		self.__vtuneMonitor = None
 		if args["vtune"].value :
 			try:
 				self.__vtuneMonitor = Gaffer.VTuneMonitor()
 			except AttributeError:
-				self.__vtuneMonitor = None
 				IECore.msg( IECore.Msg.Level.Error, "gui", "unable to create requested VTune monitor" )
 
+		if args["traceFile"].value or args["parallelism"].value :
+			self.__traceMonitor = Gaffer.TraceMonitor()
+		else :
+			self.__traceMonitor = None
+
 		self.__output = file( args["outputFile"].value, "w" ) if args["outputFile"].value else sys.stdout
 
 		self.__writeVersion( script )
@@ -324,12 +375,23 @@ class stats( Gaffer.Application ) :
 
 		self.__output.write( "\n" )
 
+		self.__writeCache( script, args )
+
+		self.__output.write( "\n" )
+
 		self.__writeContext( script, args )
 
 		self.__output.write( "\n" )
 
+		self.__writeParallelism( script, args )
+
+		self.__output.write( "\n" )
+
 		self.__output.close()
 
+		if args["traceFile"].value :
+			self.__traceMonitor.writeTrace( args["traceFile"].value )
+
 		if args["annotatedScript"].value :
 
 			if self.__performanceMonitor is not None :
@@ -483,10 +545,11 @@ class stats( Gaffer.Application ) :
 
 		if args["preCache"].value :
 			computeScene()
+			Gaffer.ValuePlug.resetCacheStatistics()
 
 		memory = _Memory.maxRSS()
 		with _Timer() as sceneTimer :
-			with self.__performanceMonitor or _NullContextManager(), self.__contextMonitor or _NullContextManager(), self.__vtuneMonitor or _NullContextManager() :
+			with self.__performanceMonitor or _NullContextManager(), self.__contextMonitor or _NullContextManager(), self.__vtuneMonitor or _NullContextManager(), self.__traceMonitor or _NullContextManager() :
 				with contextSanitiser :
 					computeScene()
 
@@ -523,10 +586,11 @@ class stats( Gaffer.Application ) :
 
 		if args["preCache"].value :
 			computeImage()
+			Gaffer.ValuePlug.resetCacheStatistics()
 
 		memory = _Memory.maxRSS()
 		with _Timer() as imageTimer :
-			with self.__performanceMonitor or _NullContextManager(), self.__contextMonitor or _NullContextManager(), self.__vtuneMonitor or _NullContextManager() :
+			with self.__performanceMonitor or _NullContextManager(), self.__contextMonitor or _NullContextManager(), self.__vtuneMonitor or _NullContextManager(), self.__traceMonitor or _NullContextManager() :
 				with contextSanitiser :
 					computeImage()
 
@@ -560,7 +624,7 @@ class stats( Gaffer.Application ) :
 
 		memory = _Memory.maxRSS()
 		with _Timer() as taskTimer :
-			with self.__performanceMonitor or _NullContextManager(), self.__contextMonitor or _NullContextManager(), self.__vtuneMonitor or _NullContextManager() :
+			with self.__performanceMonitor or _NullContextManager(), self.__contextMonitor or _NullContextManager(), self.__vtuneMonitor or _NullContextManager(), self.__traceMonitor or _NullContextManager() :
 				with Gaffer.Context( script.context() ) as context :
 					for frame in self.__frames( script, args ) :
 						context.setFrame( frame )
@@ -619,6 +683,40 @@ class stats( Gaffer.Application ) :
 					)
 				)
 
+	def __writeCache( self, script, args ) :
+
+		if not args["cache"].value :
+			return
+
+		byNodeType = collections.defaultdict( Gaffer.ValuePlug.CacheStatistics )
+		byPlugType = collections.defaultdict( Gaffer.ValuePlug.CacheStatistics )
+		for ( nodeType, plugType ), statistics in Gaffer.ValuePlug.cacheStatistics().items() :
+			byNodeType[nodeType.rpartition( ":" )[2] or "None"] += statistics
+			byPlugType[plugType.rpartition( ":" )[2]] += statistics
+
+		self.__output.write( "Cache :\n" )
+
+		for title, statistics in [
+			( "By node type", byNodeType ),
+			( "By plug type", byPlugType ),
+		] :
+			items = sorted( statistics.items(), key = lambda x : x[1].computeMisses + x[1].hashMisses, reverse = True )
+			self.__output.write( "\n  {0} :\n\n".format( title ) )
+			self.__writeItems( [ ( name, _CacheStatistics( s ) ) for name, s in items[:args["maxLinesPerMetric"].value] ] )
+
+	def __writeParallelism( self, script, args ) :
+
+		if not args["parallelism"].value :
+			return
+
+		self.__output.write( "Parallelism :\n\n" )
+		self.__output.write(
+			Gaffer.MonitorAlgo.formatStatistics(
+				self.__traceMonitor,
+				maxLinesPerMetric = args["maxLinesPerMetric"].value
+			)
+		)
+
 	def __writeContext( self, script, args ) :
 
 			if self.__contextMonitor is None :
@@ -676,6 +774,27 @@ class _Memory( object ) :
 
 		return _Memory( self.__bytes - other.__bytes )
 
+class _CacheStatistics( object ) :
+
+	def __init__( self, statistics ) :
+
+		self.__statistics = statistics
+
+	def __str__( self ) :
+
+		s = self.__statistics
+		return "hits {0}, misses {1} ({2}), evictions {3}, memory {4}, wait {5:.3f}s, hash hits {6} ({7})".format(
+			s.computeHits, s.computeMisses, self.__hitRate( s.computeHits, s.computeMisses ),
+			s.computeEvictions, _Memory( s.computeMemoryUsage ), s.computeWaitDuration / 1e9,
+			s.hashHits, self.__hitRate( s.hashHits, s.hashMisses ),
+		)
+
+	@staticmethod
+	def __hitRate( hits, misses ) :
+
+		total = hits + misses
+		return "{0:.1f}% hit rate".format( 100.0 * hits / total ) if total else "n/a"
+
 class _NullContextManager( object ) :
 
 	def __enter__( self ) :
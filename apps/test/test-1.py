@@ -73,6 +73,13 @@ class test( Gaffer.Application ) :
 			```
 			gaffer test -repeat 10 GafferImageTest.ImageNodeTest.testCacheThreadSafety
 
+			```
+
+			Run only the performance tests, saving timings and memory usage
+			and reporting regressions relative to a previous run :
+
+			```
+			gaffer test -performanceOnly -outputFile new.json -previousOutputFile baseline.json
 			```
 			"""
 		)
@@ -44,6 +44,10 @@
 #include "boost/multi_index/ordered_index.hpp"
 #include "boost/multi_index_container.hpp"
 
+#include "tbb/spin_mutex.h"
+
+#include <atomic>
+
 namespace Gaffer
 {
 
@@ -181,6 +185,19 @@ class GAFFER_API Animation : public ComputeNode
 
 				Keys m_keys;
 
+				// Called whenever the keys are edited.
+				void keysChanged();
+
+				// Evaluation uses a compact copy of the keys, stored as
+				// separate arrays sorted by time, which is much cheaper to
+				// search than `m_keys`. It is rebuilt on demand after edits.
+				void updateEvaluationData() const;
+				mutable std::vector<float> m_times;
+				mutable std::vector<float> m_values;
+				mutable std::vector<Type> m_types;
+				mutable std::atomic_bool m_evaluationDataDirty;
+				mutable tbb::spin_mutex m_evaluationDataMutex;
+
 		};
 
 		IE_CORE_DECLAREPTR( CurvePlug );
@@ -265,11 +265,17 @@ class GAFFER_API GraphComponent : public IECore::RunTimeTyped, public boost::sig
 		void addChildInternal( GraphComponentPtr child, size_t index );
 		void removeChildInternal( GraphComponentPtr child, bool emitParentChanged );
 		size_t index() const;
+		const GraphComponent *childInternal( const IECore::InternedString &name ) const;
 
 		struct Signals;
 		Signals *signals();
 
+		// Index used to accelerate name-based lookups for
+		// GraphComponents with many children.
+		struct NameIndex;
+
 		std::unique_ptr<Signals> m_signals;
+		std::unique_ptr<NameIndex> m_nameIndex;
 		IECore::InternedString m_name;
 		GraphComponent *m_parent;
 		ChildContainer m_children;
@@ -102,6 +102,7 @@ class IECORE_EXPORT Loop : public ComputeNode
 		const ValuePlug *ancestorPlug( const ValuePlug *plug, std::vector<IECore::InternedString> &relativeName ) const;
 		const ValuePlug *descendantPlug( const ValuePlug *plug, const std::vector<IECore::InternedString> &relativeName ) const;
 		const ValuePlug *sourcePlug( const ValuePlug *output, const Context *context, int &sourceLoopIndex, IECore::InternedString &indexVariable ) const;
+		bool evaluateIterationsIncrementally( const ValuePlug *output, int index ) const;
 
 };
 
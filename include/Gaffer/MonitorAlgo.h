@@ -47,6 +47,7 @@ namespace Gaffer
 class ContextMonitor;
 class Node;
 class PerformanceMonitor;
+class TraceMonitor;
 
 namespace MonitorAlgo
 {
@@ -70,6 +71,14 @@ enum PerformanceMetric
 GAFFER_API std::string formatStatistics( const PerformanceMonitor &monitor, size_t maxLinesPerMetric = 50 );
 GAFFER_API std::string formatStatistics( const PerformanceMonitor &monitor, PerformanceMetric metric, size_t maxLines = 50 );
 
+/// Summarises the parallelism achieved during the processes recorded by
+/// the TraceMonitor : the average number of busy threads, the time spent
+/// with only a single thread busy, and an estimate of the critical path
+/// through the process graph. The nodes responsible for the serial time
+/// and the critical path are listed, since these are the ones which limit
+/// scaling as the number of threads increases.
+GAFFER_API std::string formatStatistics( const TraceMonitor &monitor, size_t maxLinesPerMetric = 50 );
+
 GAFFER_API void annotate( Node &root, const PerformanceMonitor &monitor );
 GAFFER_API void annotate( Node &root, const PerformanceMonitor &monitor, PerformanceMetric metric );
 GAFFER_API void annotate( Node &root, const ContextMonitor &monitor );
@@ -0,0 +1,92 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2019, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//      * Redistributions of source code must retain the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer.
+//
+//      * Redistributions in binary form must reproduce the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer in the documentation and/or other materials provided with
+//        the distribution.
+//
+//      * Neither the name of John Haddon nor the names of
+//        any other contributors to this software may be used to endorse or
+//        promote products derived from this software without specific prior
+//        written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+#ifndef IECOREPREVIEW_PATHMATCHERALGO_H
+#define IECOREPREVIEW_PATHMATCHERALGO_H
+
+#include "IECore/PathMatcher.h"
+
+#include "tbb/enumerable_thread_specific.h"
+
+#include <vector>
+
+namespace IECorePreview
+{
+
+namespace PathMatcherAlgo
+{
+
+/// Returns the union of `matchers`, merged in parallel using a tree
+/// reduction. Because PathMatchers share structure, merging is
+/// typically much cheaper than adding the paths one by one.
+IECore::PathMatcher merge( const std::vector<IECore::PathMatcher> &matchers );
+
+/// Builds a PathMatcher from the elements in the random access range
+/// `[begin, end)`, in parallel. For each element, `f( element, path )`
+/// is called to fill `path` (a `std::vector<IECore::InternedString>`),
+/// and may return false to omit the element. `f` is called concurrently,
+/// and may throw to abort the build.
+template<typename Iterator, typename F>
+IECore::PathMatcher build( Iterator begin, Iterator end, F &&f );
+
+/// Accumulates paths added concurrently by many threads, as is
+/// typical in a parallel scene traversal. Each thread adds to its own
+/// PathMatcher, avoiding contention, and the results are merged when
+/// the traversal is complete.
+class Accumulator
+{
+
+	public :
+
+		/// May be called concurrently with other calls to `addPath()`.
+		void addPath( const std::vector<IECore::InternedString> &path );
+		/// Returns the union of all added paths. Must not be called
+		/// concurrently with `addPath()`.
+		IECore::PathMatcher result() const;
+
+	private :
+
+		tbb::enumerable_thread_specific<IECore::PathMatcher> m_matchers;
+
+};
+
+} // namespace PathMatcherAlgo
+
+} // namespace IECorePreview
+
+#include "Gaffer/Private/IECorePreview/PathMatcherAlgo.inl"
+
+#endif // IECOREPREVIEW_PATHMATCHERALGO_H
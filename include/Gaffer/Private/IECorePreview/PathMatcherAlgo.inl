@@ -0,0 +1,121 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2019, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//      * Redistributions of source code must retain the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer.
+//
+//      * Redistributions in binary form must reproduce the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer in the documentation and/or other materials provided with
+//        the distribution.
+//
+//      * Neither the name of John Haddon nor the names of
+//        any other contributors to this software may be used to endorse or
+//        promote products derived from this software without specific prior
+//        written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+#ifndef IECOREPREVIEW_PATHMATCHERALGO_INL
+#define IECOREPREVIEW_PATHMATCHERALGO_INL
+
+#include "tbb/blocked_range.h"
+#include "tbb/parallel_reduce.h"
+
+namespace IECorePreview
+{
+
+namespace PathMatcherAlgo
+{
+
+inline IECore::PathMatcher merge( const std::vector<IECore::PathMatcher> &matchers )
+{
+	if( matchers.size() == 1 )
+	{
+		return matchers.front();
+	}
+
+	tbb::task_group_context taskGroupContext( tbb::task_group_context::isolated );
+	return tbb::parallel_reduce(
+		tbb::blocked_range<size_t>( 0, matchers.size() ),
+		IECore::PathMatcher(),
+		[&matchers]( const tbb::blocked_range<size_t> &range, IECore::PathMatcher result ) {
+			for( size_t i = range.begin(); i != range.end(); ++i )
+			{
+				result.addPaths( matchers[i] );
+			}
+			return result;
+		},
+		[]( IECore::PathMatcher a, const IECore::PathMatcher &b ) {
+			a.addPaths( b );
+			return a;
+		},
+		tbb::auto_partitioner(),
+		taskGroupContext
+	);
+}
+
+template<typename Iterator, typename F>
+IECore::PathMatcher build( Iterator begin, Iterator end, F &&f )
+{
+	// Each task builds a PathMatcher for a contiguous block of elements,
+	// and blocks are then merged pairwise. A large grain size keeps the
+	// number of merges small relative to the number of paths.
+	tbb::task_group_context taskGroupContext( tbb::task_group_context::isolated );
+	return tbb::parallel_reduce(
+		tbb::blocked_range<Iterator>( begin, end, 1000 ),
+		IECore::PathMatcher(),
+		[&f]( const tbb::blocked_range<Iterator> &range, IECore::PathMatcher result ) {
+			std::vector<IECore::InternedString> path;
+			for( Iterator it = range.begin(); it != range.end(); ++it )
+			{
+				path.clear();
+				if( f( *it, path ) )
+				{
+					result.addPath( path );
+				}
+			}
+			return result;
+		},
+		[]( IECore::PathMatcher a, const IECore::PathMatcher &b ) {
+			a.addPaths( b );
+			return a;
+		},
+		tbb::auto_partitioner(),
+		taskGroupContext
+	);
+}
+
+inline void Accumulator::addPath( const std::vector<IECore::InternedString> &path )
+{
+	m_matchers.local().addPath( path );
+}
+
+inline IECore::PathMatcher Accumulator::result() const
+{
+	return merge( std::vector<IECore::PathMatcher>( m_matchers.begin(), m_matchers.end() ) );
+}
+
+} // namespace PathMatcherAlgo
+
+} // namespace IECorePreview
+
+#endif // IECOREPREVIEW_PATHMATCHERALGO_INL
@@ -0,0 +1,178 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2019, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//      * Redistributions of source code must retain the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer.
+//
+//      * Redistributions in binary form must reproduce the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer in the documentation and/or other materials provided with
+//        the distribution.
+//
+//      * Neither the name of John Haddon nor the names of
+//        any other contributors to this software may be used to endorse or
+//        promote products derived from this software without specific prior
+//        written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+#ifndef GAFFER_TRACEMONITOR_H
+#define GAFFER_TRACEMONITOR_H
+
+#include "Gaffer/Monitor.h"
+
+#include "IECore/InternedString.h"
+#include "IECore/MurmurHash.h"
+
+#include "boost/chrono.hpp"
+#include "boost/unordered_map.hpp"
+
+#include "tbb/enumerable_thread_specific.h"
+
+#include <iosfwd>
+#include <vector>
+
+namespace Gaffer
+{
+
+IE_CORE_FORWARDDECLARE( Plug )
+
+/// A monitor which records a timeline of the processes performed
+/// on each thread. Unlike the PerformanceMonitor, which aggregates
+/// statistics per plug, the TraceMonitor records when each process
+/// started and finished, and on which thread. This makes it
+/// possible to visualise contention and poor parallelism using the
+/// Chrome Trace Event format, as viewed in `chrome://tracing` or
+/// https://ui.perfetto.dev.
+///
+/// Events are stored in a fixed-size ring buffer per thread, so
+/// that memory usage is bounded even for long running processes.
+/// When a buffer is full, the oldest events on that thread are
+/// discarded.
+///
+/// > Note : Processes are only launched on cache misses, so every
+/// > recorded event represents a miss. Cache hits are not recorded.
+class GAFFER_API TraceMonitor : public Monitor
+{
+
+	public :
+
+		TraceMonitor( size_t maxEventsPerThread = 1000000 );
+		~TraceMonitor() override;
+
+		IE_CORE_DECLAREMEMBERPTR( TraceMonitor )
+
+		struct Event
+		{
+			/// The plug the process was performed for. This is
+			/// kept alive by the monitor, so is always valid.
+			const Plug *plug;
+			/// The type of the process.
+			IECore::InternedString type;
+			/// The hash of the context the process was performed in.
+			IECore::MurmurHash contextHash;
+			/// A small integer uniquely identifying the thread that
+			/// performed the process.
+			size_t threadIndex;
+			/// Start time and duration, measured relative to the
+			/// construction of the monitor.
+			boost::chrono::nanoseconds start;
+			boost::chrono::nanoseconds duration;
+			/// The index of the event for the process that launched
+			/// this one, or `noParent` if it is unknown. Because TBB
+			/// tasks inherit the ThreadState of the thread that
+			/// spawned them, the parent may have run on a different
+			/// thread. Indices refer to the vector returned by `events()`.
+			size_t parent;
+			static const size_t noParent;
+		};
+
+		typedef std::vector<Event> Events;
+
+		/// Returns all retained events, sorted by start time,
+		/// with parent indices resolved.
+		Events events() const;
+		/// Returns the number of events discarded because a thread's
+		/// buffer was full.
+		size_t numDiscardedEvents() const;
+
+		/// Writes all retained events in the Chrome Trace Event
+		/// JSON format.
+		void writeTrace( std::ostream &stream ) const;
+		void writeTrace( const std::string &fileName ) const;
+
+	protected :
+
+		void processStarted( const Process *process ) override;
+		void processFinished( const Process *process ) override;
+
+	private :
+
+		typedef boost::chrono::high_resolution_clock Clock;
+
+		// Event, plus the information needed to resolve
+		// `Event::parent` in `events()`.
+		struct Record
+		{
+			Event event;
+			const Process *process;
+			const Process *parentProcess;
+		};
+
+		// As with the PerformanceMonitor, we accumulate data into
+		// thread local storage so that recording is lock-free.
+		struct ThreadData
+		{
+			ThreadData();
+			// Start times for the processes currently running
+			// on this thread, innermost last.
+			std::vector<Clock::time_point> startStack;
+			// Ring buffer of completed events. `next` is the
+			// index that the next event will be written to.
+			std::vector<Record> records;
+			size_t next;
+			size_t numDiscarded;
+			size_t threadIndex;
+			// Keeps alive all plugs referenced by `records`, counting
+			// the records for each so that plugs can be released when
+			// their last record is overwritten. We key by raw pointer
+			// so that lookups don't need to touch the reference count.
+			struct PlugReference
+			{
+				ConstPlugPtr plug;
+				size_t numRecords;
+			};
+			boost::unordered_map<const Plug *, PlugReference> plugs;
+		};
+
+		typedef tbb::enumerable_thread_specific<ThreadData, tbb::cache_aligned_allocator<ThreadData>, tbb::ets_key_per_instance> ThreadDataStorage;
+		ThreadDataStorage m_threadData;
+
+		const size_t m_maxEventsPerThread;
+		const Clock::time_point m_origin;
+
+};
+
+IE_CORE_DECLAREPTR( TraceMonitor )
+
+} // namespace Gaffer
+
+#endif // GAFFER_TRACEMONITOR_H
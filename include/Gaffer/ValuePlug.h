@@ -42,6 +42,9 @@
 
 #include "IECore/Object.h"
 
+#include "boost/chrono.hpp"
+#include "boost/unordered_map.hpp"
+
 namespace Gaffer
 {
 
@@ -156,6 +159,55 @@ class GAFFER_API ValuePlug : public Plug
 		static void setHashCacheSizeLimit( size_t maxEntriesPerThread );
 		//@}
 
+		/// @name Cache statistics
+		/// Statistics describing the behaviour of the caches may be collected
+		/// to aid in the tuning of cache limits. Collection is disabled by default
+		/// because it has a small overhead.
+		////////////////////////////////////////////////////////////////////
+		//@{
+		struct CacheStatistics
+		{
+
+			CacheStatistics();
+
+			/// Number of value lookups served by the cache, including those
+			/// which waited for a compute in progress on another thread.
+			size_t computeHits;
+			/// Number of value lookups which performed a compute.
+			size_t computeMisses;
+			/// Number of values removed from the cache, either to remain
+			/// within the memory limit or because of `clearCache()`.
+			size_t computeEvictions;
+			/// Memory currently held in the cache, in bytes. Only values
+			/// added while statistics were enabled are accounted for.
+			size_t computeMemoryUsage;
+			/// Time spent in lookups which did not perform the compute
+			/// themselves. This is dominated by time spent waiting for
+			/// computes in progress on other threads.
+			boost::chrono::nanoseconds computeWaitDuration;
+			/// Number of hash lookups served by the hash caches.
+			size_t hashHits;
+			/// Number of hash lookups which required a call to
+			/// `ComputeNode::hash()`.
+			size_t hashMisses;
+
+			CacheStatistics & operator += ( const CacheStatistics &rhs );
+
+		};
+
+		/// Statistics are collected separately for each combination of
+		/// node type and plug type, stored in that order in the key.
+		typedef std::pair<IECore::TypeId, IECore::TypeId> CacheStatisticsKey;
+		typedef boost::unordered_map<CacheStatisticsKey, CacheStatistics> CacheStatisticsMap;
+
+		static void setCacheStatisticsEnabled( bool enabled );
+		static bool getCacheStatisticsEnabled();
+		/// Returns the statistics collected since they were last reset.
+		static CacheStatisticsMap cacheStatistics();
+		/// Must not be called while computations are in progress.
+		static void resetCacheStatistics();
+		//@}
+
 	protected :
 
 		/// This constructor must be used by all derived classes which wish
@@ -0,0 +1,138 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2019, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//      * Redistributions of source code must retain the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer.
+//
+//      * Redistributions in binary form must reproduce the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer in the documentation and/or other materials provided with
+//        the distribution.
+//
+//      * Neither the name of John Haddon nor the names of
+//        any other contributors to this software may be used to endorse or
+//        promote products derived from this software without specific prior
+//        written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+#ifndef IECORESCENEPREVIEW_SHADERCACHE_H
+#define IECORESCENEPREVIEW_SHADERCACHE_H
+
+#include "Gaffer/Private/IECorePreview/LRUCache.h"
+
+#include "IECoreScene/ShaderNetwork.h"
+
+#include "IECore/MurmurHash.h"
+
+#include "tbb/concurrent_hash_map.h"
+
+#include <atomic>
+
+namespace IECoreScenePreview
+{
+
+/// Utility to help renderer backends convert each unique ShaderNetwork
+/// only once, however many locations it is assigned to. Networks are
+/// identified by hash, and converted on demand by a backend-specific
+/// function. Converted shaders are shared via reference counting, so
+/// they remain valid for as long as any renderer object uses them.
+///
+/// The hash of each network is memoised against the network itself,
+/// so that networks shared between many attribute sets (as is typical
+/// of those produced by a ShaderAssignment) are only hashed once. The
+/// memo holds a reference to each network it contains, so it is limited
+/// to the most recently used `hashCacheSize` networks. At most that many
+/// networks are kept alive by the memo once their attributes are gone.
+///
+/// `Value` must derive from IECore::RefCounted.
+template<typename Value>
+class ShaderCache
+{
+
+	public :
+
+		typedef boost::intrusive_ptr<Value> ValuePtr;
+
+		ShaderCache( size_t hashCacheSize = 10000 );
+
+		/// Returns the shader for `network`, calling `converter( network, hash )`
+		/// to create it if it is not already in the cache. The converter must
+		/// return something convertible to `ValuePtr`. It is called with a null
+		/// `network` when `network` is null, allowing backends to provide a
+		/// default. May be called concurrently with other `get()` calls.
+		template<typename Converter>
+		ValuePtr get( const IECoreScene::ShaderNetwork *network, Converter &&converter );
+
+		/// Returns the hash of `network`, which will usually only be computed
+		/// once, until the network drops out of the memo or `clearUnused()`
+		/// is called. Returns a default hash for a null network.
+		IECore::MurmurHash hash( const IECoreScene::ShaderNetwork *network );
+
+		/// Removes all shaders which are not referenced from outside the
+		/// cache, and forgets all memoised hashes. Must not be called
+		/// concurrently with anything.
+		void clearUnused();
+
+		/// Calls `f( shader )` for each shader in the cache. Must not be called
+		/// concurrently with `get()` or `clearUnused()`.
+		template<typename F>
+		void forEach( F &&f ) const;
+
+		struct Statistics
+		{
+			/// The number of calls to `get()`.
+			size_t lookups;
+			/// The number of networks converted.
+			size_t conversions;
+			/// The number of networks hashed.
+			size_t hashes;
+			/// The number of shaders currently in the cache.
+			size_t size;
+		};
+
+		Statistics statistics() const;
+
+	private :
+
+		typedef tbb::concurrent_hash_map<IECore::MurmurHash, ValuePtr> Cache;
+		Cache m_cache;
+
+		// We hold a reference to each network so that its address can't
+		// be reused by another network while our hash is memoised. The
+		// LRUCache drops the least recently used networks so that we don't
+		// keep every network alive until `clearUnused()`, which some
+		// backends only call from `render()`.
+		typedef std::pair<IECoreScene::ConstShaderNetworkPtr, IECore::MurmurHash> HashCacheEntry;
+		typedef IECorePreview::LRUCache<const IECoreScene::ShaderNetwork *, HashCacheEntry> HashCache;
+		HashCache m_hashCache;
+
+		std::atomic<size_t> m_lookups;
+		std::atomic<size_t> m_conversions;
+		std::atomic<size_t> m_hashes;
+
+};
+
+} // namespace IECoreScenePreview
+
+#include "GafferScene/Private/IECoreScenePreview/ShaderCache.inl"
+
+#endif // IECORESCENEPREVIEW_SHADERCACHE_H
@@ -0,0 +1,131 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2019, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//      * Redistributions of source code must retain the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer.
+//
+//      * Redistributions in binary form must reproduce the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer in the documentation and/or other materials provided with
+//        the distribution.
+//
+//      * Neither the name of John Haddon nor the names of
+//        any other contributors to this software may be used to endorse or
+//        promote products derived from this software without specific prior
+//        written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+#ifndef IECORESCENEPREVIEW_SHADERCACHE_INL
+#define IECORESCENEPREVIEW_SHADERCACHE_INL
+
+#include <vector>
+
+namespace IECoreScenePreview
+{
+
+template<typename Value>
+ShaderCache<Value>::ShaderCache( size_t hashCacheSize )
+	:	m_hashCache(
+			[this] ( const IECoreScene::ShaderNetwork *network, size_t &cost ) {
+				cost = 1;
+				m_hashes++;
+				return HashCacheEntry( network, network->Object::hash() );
+			},
+			hashCacheSize
+		),
+		m_lookups( 0 ), m_conversions( 0 ), m_hashes( 0 )
+{
+}
+
+template<typename Value>
+template<typename Converter>
+typename ShaderCache<Value>::ValuePtr ShaderCache<Value>::get( const IECoreScene::ShaderNetwork *network, Converter &&converter )
+{
+	m_lookups++;
+
+	typename Cache::accessor a;
+	m_cache.insert( a, hash( network ) );
+	if( !a->second )
+	{
+		a->second = converter( network, a->first );
+		m_conversions++;
+	}
+	return a->second;
+}
+
+template<typename Value>
+IECore::MurmurHash ShaderCache<Value>::hash( const IECoreScene::ShaderNetwork *network )
+{
+	if( !network )
+	{
+		return IECore::MurmurHash();
+	}
+
+	return m_hashCache.get( network ).second;
+}
+
+template<typename Value>
+void ShaderCache<Value>::clearUnused()
+{
+	std::vector<IECore::MurmurHash> toErase;
+	for( typename Cache::iterator it = m_cache.begin(), eIt = m_cache.end(); it != eIt; ++it )
+	{
+		if( it->second->refCount() == 1 )
+		{
+			// Only one reference - this is ours, so
+			// nothing outside of the cache is using the
+			// shader.
+			toErase.push_back( it->first );
+		}
+	}
+	for( std::vector<IECore::MurmurHash>::const_iterator it = toErase.begin(), eIt = toErase.end(); it != eIt; ++it )
+	{
+		m_cache.erase( *it );
+	}
+
+	m_hashCache.clear();
+}
+
+template<typename Value>
+template<typename F>
+void ShaderCache<Value>::forEach( F &&f ) const
+{
+	for( typename Cache::const_iterator it = m_cache.begin(), eIt = m_cache.end(); it != eIt; ++it )
+	{
+		f( it->second.get() );
+	}
+}
+
+template<typename Value>
+typename ShaderCache<Value>::Statistics ShaderCache<Value>::statistics() const
+{
+	Statistics result;
+	result.lookups = m_lookups;
+	result.conversions = m_conversions;
+	result.hashes = m_hashes;
+	result.size = m_cache.size();
+	return result;
+}
+
+} // namespace IECoreScenePreview
+
+#endif // IECORESCENEPREVIEW_SHADERCACHE_INL
@@ -42,9 +42,12 @@
 
 #include "Gaffer/BackgroundTask.h"
 
+#include "IECoreScene/Camera.h"
+
 #include "boost/signals.hpp"
 
 #include <functional>
+#include <memory>
 
 namespace GafferScene
 {
@@ -74,6 +77,16 @@ class GAFFERSCENE_API RenderController : public boost::signals::trackable
 		void setMinimumExpansionDepth( size_t depth );
 		size_t getMinimumExpansionDepth() const;
 
+		/// Specifies a camera used to prioritise the work done by
+		/// `updateInBackground()`. When the whole scene needs updating,
+		/// locations which cover a significant fraction of the camera's
+		/// view are updated before the rest, so that they can be shown
+		/// sooner. A copy of the camera is taken. Pass `nullptr` to
+		/// disable prioritisation.
+		void setPriorityCamera( const IECoreScene::Camera *camera, const Imath::M44f &transform = Imath::M44f() );
+		const IECoreScene::Camera *getPriorityCamera() const;
+		const Imath::M44f &getPriorityCameraTransform() const;
+
 		typedef boost::signal<void (RenderController &)> UpdateRequiredSignal;
 		UpdateRequiredSignal &updateRequiredSignal();
 
@@ -93,9 +106,8 @@ class GAFFERSCENE_API RenderController : public boost::signals::trackable
 			NoGlobalComponent = 0,
 			GlobalsGlobalComponent = 1,
 			SetsGlobalComponent = 2,
-			RenderSetsGlobalComponent = 4,
-			CameraOptionsGlobalComponent = 8,
-			AllGlobalComponents = GlobalsGlobalComponent | SetsGlobalComponent | RenderSetsGlobalComponent | CameraOptionsGlobalComponent
+			CameraOptionsGlobalComponent = 4,
+			AllGlobalComponents = GlobalsGlobalComponent | SetsGlobalComponent | CameraOptionsGlobalComponent
 		};
 
 		void plugDirtied( const Gaffer::Plug *plug );
@@ -103,13 +115,21 @@ class GAFFERSCENE_API RenderController : public boost::signals::trackable
 		void requestUpdate();
 		void dirtyGlobals( unsigned components );
 		void dirtySceneGraphs( unsigned components );
-
-		void updateInternal( const ProgressCallback &callback = ProgressCallback(), const IECore::PathMatcher *pathsToUpdate = nullptr );
+		void dirtySceneGraphs( const IECore::PathMatcher &paths, unsigned components );
+		void prepareUpdate();
+
+		// If `importantPathsOnly` is true, `pathsToUpdate` is expected to
+		// have been computed by `importantPaths()`. All cameras, lights and
+		// light filters are updated, but objects are only updated at the
+		// exact locations in `pathsToUpdate`, and not at their descendants.
+		void updateInternal( const ProgressCallback &callback = ProgressCallback(), const IECore::PathMatcher *pathsToUpdate = nullptr, bool importantPathsOnly = false );
+		IECore::PathMatcher importantPaths( const IECoreScene::Camera *camera, const Imath::M44f &cameraTransform ) const;
 		void updateDefaultCamera();
 		void cancelBackgroundTask();
 
 		class SceneGraph;
 		class SceneGraphUpdateTask;
+		class AffectedPathsHint;
 
 		ConstScenePlugPtr m_scene;
 		Gaffer::ConstContextPtr m_context;
@@ -118,6 +138,9 @@ class GAFFERSCENE_API RenderController : public boost::signals::trackable
 		IECore::PathMatcher m_expandedPaths;
 		size_t m_minimumExpansionDepth;
 
+		IECoreScene::ConstCameraPtr m_priorityCamera;
+		Imath::M44f m_priorityCameraTransform;
+
 		boost::signals::scoped_connection m_plugDirtiedConnection;
 		boost::signals::scoped_connection m_contextChangedConnection;
 
@@ -127,6 +150,7 @@ class GAFFERSCENE_API RenderController : public boost::signals::trackable
 
 		std::vector<std::unique_ptr<SceneGraph> > m_sceneGraphs;
 		unsigned m_dirtyGlobalComponents;
+		unsigned m_dirtySceneGraphComponents;
 		unsigned m_changedGlobalComponents;
 		IECore::ConstCompoundObjectPtr m_globals;
 		RendererAlgo::RenderSets m_renderSets;
@@ -135,6 +159,8 @@ class GAFFERSCENE_API RenderController : public boost::signals::trackable
 
 		std::shared_ptr<Gaffer::BackgroundTask> m_backgroundTask;
 
+		std::unique_ptr<AffectedPathsHint> m_affectedPathsHint;
+
 };
 
 } // namespace GafferScene
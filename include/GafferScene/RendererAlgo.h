@@ -115,8 +115,12 @@ class GAFFERSCENE_API RenderSets : boost::noncopyable
 		};
 
 		/// Returns a bitmask describing which sets
-		/// changed.
-		unsigned update( const ScenePlug *scene );
+		/// changed. If `changedPaths` is passed, the
+		/// locations whose membership of the "render:"
+		/// sets changed are added to it. Note that
+		/// descendants of those locations are affected
+		/// too, since membership is inherited.
+		unsigned update( const ScenePlug *scene, IECore::PathMatcher *changedPaths = nullptr );
 		void clear();
 
 		const IECore::PathMatcher &camerasSet() const;
@@ -36,138 +36,111 @@
 
 #include "Gaffer/Context.h"
 
+#include "tbb/blocked_range.h"
+#include "tbb/parallel_for.h"
 #include "tbb/task.h"
 
+#include <type_traits>
+
 namespace GafferScene
 {
 
 namespace Detail
 {
 
-template <class ThreadableFunctor>
-class TraverseTask : public tbb::task
+template<typename F>
+class FunctionTask : public tbb::task
 {
 
 	public :
 
-		TraverseTask(
-			const GafferScene::ScenePlug *scene,
-			const Gaffer::ThreadState &threadState,
-			ThreadableFunctor &f
-		)
-			:	m_scene( scene ), m_threadState( threadState ), m_f( f )
-		{
-		}
-
-		~TraverseTask() override
+		FunctionTask( F &f )
+			:	m_f( f )
 		{
 		}
 
 		task *execute() override
 		{
-			ScenePlug::PathScope pathScope( m_threadState, m_path );
-
-			if( m_f( m_scene, m_path ) )
-			{
-				IECore::ConstInternedStringVectorDataPtr childNamesData = m_scene->childNamesPlug()->getValue();
-				const std::vector<IECore::InternedString> &childNames = childNamesData->readable();
-
-				set_ref_count( 1 + childNames.size() );
-
-				ScenePlug::ScenePath childPath = m_path;
-				childPath.push_back( IECore::InternedString() ); // space for the child name
-				for( std::vector<IECore::InternedString>::const_iterator it = childNames.begin(), eIt = childNames.end(); it != eIt; it++ )
-				{
-					childPath[m_path.size()] = *it;
-					TraverseTask *t = new( allocate_child() ) TraverseTask( *this, childPath );
-					spawn( *t );
-				}
-				wait_for_all();
-			}
-
+			m_f();
 			return nullptr;
 		}
 
-	protected :
-
-		TraverseTask( const TraverseTask &other, const ScenePlug::ScenePath &path )
-			:	m_scene( other.m_scene ),
-			m_threadState( other.m_threadState ),
-			m_f( other.m_f ),
-			m_path( path )
-		{
-		}
-
 	private :
 
-		const GafferScene::ScenePlug *m_scene;
-		const Gaffer::ThreadState &m_threadState;
-		ThreadableFunctor &m_f;
-		GafferScene::ScenePlug::ScenePath m_path;
+		F &m_f;
 
 };
 
-template<typename ThreadableFunctor>
-class LocationTask : public tbb::task
+// Calls `f` in a root task with its own isolated task group context,
+// preventing outer tasks silently cancelling our tasks.
+template<typename F>
+void isolatedInvoke( F &&f )
 {
+	using Task = FunctionTask<typename std::remove_reference<F>::type>;
+	tbb::task_group_context taskGroupContext( tbb::task_group_context::isolated );
+	Task *task = new( tbb::task::allocate_root( taskGroupContext ) ) Task( f );
+	tbb::task::spawn_root_and_wait( *task );
+}
 
-	public :
-
-		LocationTask(
-			const GafferScene::ScenePlug *scene,
-			const Gaffer::ThreadState &threadState,
-			const ScenePlug::ScenePath &path,
-			ThreadableFunctor &f
-		)
-			:	m_scene( scene ), m_threadState( threadState ), m_path( path ), m_f( f )
-		{
-		}
-
-		~LocationTask() override
-		{
-		}
-
-		task *execute() override
-		{
-			ScenePlug::PathScope pathScope( m_threadState, m_path );
-
-			if( !m_f( m_scene, m_path ) )
-			{
-				return nullptr;
-			}
-
-			IECore::ConstInternedStringVectorDataPtr childNamesData = m_scene->childNamesPlug()->getValue();
-			const std::vector<IECore::InternedString> &childNames = childNamesData->readable();
-			if( childNames.empty() )
-			{
-				return nullptr;
-			}
-
-			std::vector<ThreadableFunctor> childFunctors( childNames.size(), m_f );
-
-			set_ref_count( 1 + childNames.size() );
+// Visits the children of a location in parallel. Rather than spawning a
+// task per child up front, we let `parallel_for()` split the children into
+// chunks, so that locations with very large numbers of children don't
+// require a correspondingly large number of tasks, paths and functors to
+// exist at once.
+template<typename F>
+void parallelForEachChild( const ScenePlug *scene, const ScenePlug::ScenePath &path, F &&f )
+{
+	IECore::ConstInternedStringVectorDataPtr childNamesData = scene->childNamesPlug()->getValue();
+	const std::vector<IECore::InternedString> &childNames = childNamesData->readable();
+	if( childNames.empty() )
+	{
+		return;
+	}
 
-			ScenePlug::ScenePath childPath = m_path;
+	tbb::parallel_for(
+		tbb::blocked_range<size_t>( 0, childNames.size() ),
+		[&]( const tbb::blocked_range<size_t> &range ) {
+			ScenePlug::ScenePath childPath = path;
 			childPath.push_back( IECore::InternedString() ); // space for the child name
-			for( size_t i = 0, e = childNames.size(); i < e; ++i )
+			for( size_t i = range.begin(); i != range.end(); ++i )
 			{
 				childPath.back() = childNames[i];
-				LocationTask *t = new( allocate_child() ) LocationTask( m_scene, m_threadState, childPath, childFunctors[i] );
-				spawn( *t );
+				f( childPath );
 			}
-			wait_for_all();
-
-			return nullptr;
 		}
+	);
+}
 
-	private :
-
-		const GafferScene::ScenePlug *m_scene;
-		const Gaffer::ThreadState &m_threadState;
-		const GafferScene::ScenePlug::ScenePath m_path;
-		ThreadableFunctor &m_f;
+template <class ThreadableFunctor>
+void traverseWalk( const GafferScene::ScenePlug *scene, const Gaffer::ThreadState &threadState, const ScenePlug::ScenePath &path, ThreadableFunctor &f )
+{
+	ScenePlug::PathScope pathScope( threadState, path );
+	if( f( scene, path ) )
+	{
+		parallelForEachChild(
+			scene, path,
+			[&]( const ScenePlug::ScenePath &childPath ) {
+				traverseWalk( scene, threadState, childPath, f );
+			}
+		);
+	}
+}
 
-};
+template<typename ThreadableFunctor>
+void locationsWalk( const GafferScene::ScenePlug *scene, const Gaffer::ThreadState &threadState, const ScenePlug::ScenePath &path, ThreadableFunctor &f )
+{
+	ScenePlug::PathScope pathScope( threadState, path );
+	if( f( scene, path ) )
+	{
+		parallelForEachChild(
+			scene, path,
+			[&]( const ScenePlug::ScenePath &childPath ) {
+				ThreadableFunctor childFunctor( f );
+				locationsWalk( scene, threadState, childPath, childFunctor );
+			}
+		);
+	}
+}
 
 template <class ThreadableFunctor>
 struct ThreadableFilteredFunctor
@@ -242,17 +215,19 @@ void parallelProcessLocations( const GafferScene::ScenePlug *scene, ThreadableFu
 template <class ThreadableFunctor>
 void parallelProcessLocations( const GafferScene::ScenePlug *scene, ThreadableFunctor &f, const ScenePlug::ScenePath &root )
 {
-	tbb::task_group_context taskGroupContext( tbb::task_group_context::isolated ); // Prevents outer tasks silently cancelling our tasks
-	Detail::LocationTask<ThreadableFunctor> *task = new( tbb::task::allocate_root( taskGroupContext ) ) Detail::LocationTask<ThreadableFunctor>( scene, Gaffer::ThreadState::current(), root, f );
-	tbb::task::spawn_root_and_wait( *task );
+	const Gaffer::ThreadState &threadState = Gaffer::ThreadState::current();
+	Detail::isolatedInvoke(
+		[&] { Detail::locationsWalk( scene, threadState, root, f ); }
+	);
 }
 
 template <class ThreadableFunctor>
 void parallelTraverse( const GafferScene::ScenePlug *scene, ThreadableFunctor &f )
 {
-	tbb::task_group_context taskGroupContext( tbb::task_group_context::isolated ); // Prevents outer tasks silently cancelling our tasks
-	Detail::TraverseTask<ThreadableFunctor> *task = new( tbb::task::allocate_root( taskGroupContext ) ) Detail::TraverseTask<ThreadableFunctor>( scene, Gaffer::ThreadState::current(), f );
-	tbb::task::spawn_root_and_wait( *task );
+	const Gaffer::ThreadState &threadState = Gaffer::ThreadState::current();
+	Detail::isolatedInvoke(
+		[&] { Detail::traverseWalk( scene, threadState, ScenePlug::ScenePath(), f ); }
+	);
 }
 
 template <class ThreadableFunctor>
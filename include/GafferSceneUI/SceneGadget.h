@@ -89,8 +89,8 @@ class GAFFERSCENEUI_API SceneGadget : public GafferUI::Gadget
 		void setSelection( const IECore::PathMatcher &selection );
 
 		/// Specifies options to control the OpenGL renderer. These are used
-		/// to specify wireframe/point drawing and colours etc. A copy of
-		/// `options` is taken.
+		/// to specify wireframe/point drawing and colours, culling and
+		/// level of detail etc. A copy of `options` is taken.
 		void setOpenGLOptions( const IECore::CompoundObject *options );
 		const IECore::CompoundObject *getOpenGLOptions() const;
 
@@ -185,7 +185,7 @@ class GAFFERSCENEUI_API SceneGadget : public GafferUI::Gadget
 		mutable GafferScene::RenderController m_controller;
 		mutable std::shared_ptr<Gaffer::BackgroundTask> m_updateTask;
 		bool m_updateErrored;
-		std::atomic_bool m_renderRequestPending;
+		mutable std::atomic_bool m_renderRequestPending;
 
 		IECore::ConstCompoundObjectPtr m_openGLOptions;
 		IECore::PathMatcher m_selection;
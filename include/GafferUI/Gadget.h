@@ -291,6 +291,12 @@ class GAFFERUI_API Gadget : public Gaffer::GraphComponent
 		/// of its children will render anything for the specified layer.
 		/// The default implementation returns true.
 		virtual bool hasLayer( Layer layer ) const;
+		/// May return false to indicate that the specified child need
+		/// not be rendered, for instance because it lies outside the
+		/// region currently being drawn. Called after doRenderLayer(),
+		/// so implementations may use that to prepare. The default
+		/// implementation returns true.
+		virtual bool shouldRenderChild( const Gadget *child ) const;
 
 	private :
 
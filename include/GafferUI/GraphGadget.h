@@ -43,6 +43,8 @@
 #include "Gaffer/CompoundNumericPlug.h"
 #include "Gaffer/Plug.h"
 
+#include <memory>
+
 namespace Gaffer
 {
 IE_CORE_FORWARDDECLARE( Node );
@@ -186,10 +188,15 @@ class GAFFERUI_API GraphGadget : public ContainerGadget
 		NodeGadget *nodeGadgetAt( const IECore::LineSegment3f &lineInGadgetSpace ) const;
 		/// Returns the connectionGadget under the specified line.
 		ConnectionGadget *connectionGadgetAt( const IECore::LineSegment3f &lineInGadgetSpace ) const;
+		/// Finds all the NodeGadgets whose bounds intersect the specified region
+		/// and appends them to the specified vector. Returns the new size of the vector.
+		/// This uses a spatial index so is efficient even for very large graphs.
+		size_t nodeGadgetsIntersecting( const Imath::Box2f &regionInGadgetSpace, std::vector<NodeGadget *> &nodeGadgets ) const;
 
 	protected :
 
 		void doRenderLayer( Layer layer, const Style *style ) const override;
+		bool shouldRenderChild( const Gadget *child ) const override;
 
 	private :
 
@@ -207,6 +214,7 @@ class GAFFERUI_API GraphGadget : public ContainerGadget
 		void noduleAdded( Nodule *nodule );
 		void noduleRemoved( Nodule *nodule );
 		void nodeMetadataChanged( IECore::TypeId nodeTypeId, IECore::InternedString key, Gaffer::Node *node );
+		void nodeGadgetRenderRequested( Gadget *gadget );
 
 		bool keyPressed( GadgetPtr gadget, const KeyEvent &event );
 
@@ -265,6 +273,7 @@ class GAFFERUI_API GraphGadget : public ContainerGadget
 			boost::signals::scoped_connection plugSetConnection;
 			boost::signals::scoped_connection noduleAddedConnection;
 			boost::signals::scoped_connection noduleRemovedConnection;
+			boost::signals::scoped_connection renderRequestConnection;
 		};
 		typedef std::map<const Gaffer::Node *, NodeGadgetEntry> NodeGadgetMap;
 		NodeGadgetMap m_nodeGadgets;
@@ -272,6 +281,12 @@ class GAFFERUI_API GraphGadget : public ContainerGadget
 		typedef std::map<const Nodule *, ConnectionGadget *> ConnectionGadgetMap;
 		ConnectionGadgetMap m_connectionGadgets;
 
+		// Indexes the bounds of all NodeGadgets and ConnectionGadgets,
+		// so that we can cull rendering and find gadgets in a region
+		// without visiting the whole graph.
+		class SpatialIndex;
+		std::unique_ptr<SpatialIndex> m_spatialIndex;
+
 		enum DragMode
 		{
 			None,
@@ -282,6 +297,7 @@ class GAFFERUI_API GraphGadget : public ContainerGadget
 
 		Imath::V2f m_dragStartPosition;
 		Imath::V2f m_lastDragPosition;
+		Imath::Box2f m_dragSelectionBound;
 		DragMode m_dragMode;
 		ConnectionGadget *m_dragReconnectCandidate;
 		Nodule *m_dragReconnectSrcNodule;
@@ -1729,5 +1729,39 @@ class DispatcherTest( GafferTest.TestCase ) :
 		with self.assertRaisesRegexp( RuntimeError, "TaskPlug \"ScriptNode.badNode.task\" has no TaskNode" ) :
 			dispatcher.dispatch( [ s["taskList"] ] )
 
+	@GafferTest.TestRunner.PerformanceTestMethod()
+	def testBatchingPerformance( self ) :
+
+		# A wide and deep network of tasks, dispatched over
+		# many frames with a variety of batch sizes. We use the
+		# NullDispatcher so we only measure the construction of
+		# the batches, and not their execution.
+
+		s = Gaffer.ScriptNode()
+
+		previousRow = []
+		for row in range( 0, 10 ) :
+			currentRow = []
+			for column in range( 0, 10 ) :
+				n = GafferDispatchTest.LoggingTaskNode( "n{0}_{1}".format( row, column ) )
+				n["dispatcher"]["batchSize"].setValue( 1 + column )
+				for i, p in enumerate( previousRow ) :
+					n["preTasks"][i].setInput( p["task"] )
+				s.addChild( n )
+				currentRow.append( n )
+			previousRow = currentRow
+
+		s["taskList"] = GafferDispatch.TaskList()
+		for i, p in enumerate( previousRow ) :
+			s["taskList"]["preTasks"][i].setInput( p["task"] )
+
+		dispatcher = self.NullDispatcher()
+		dispatcher["jobsDirectory"].setValue( self.temporaryDirectory() )
+		dispatcher["framesMode"].setValue( GafferDispatch.Dispatcher.FramesMode.CustomRange )
+		dispatcher["frameRange"].setValue( "1-100" )
+
+		with GafferTest.TestRunner.PerformanceScope() :
+			dispatcher.dispatch( [ s["taskList"] ] )
+
 if __name__ == "__main__":
 	unittest.main()
@@ -191,5 +191,23 @@ class BlurTest( GafferImageTest.ImageTestCase ) :
 
 		self.assertImagesEqual( finalCrop["out"], expectedReader["out"], maxDifference = 0.00001, ignoreMetadata = True )
 
+	@GafferTest.TestRunner.PerformanceTestMethod()
+	def testPerformance( self ) :
+
+		checker = GafferImage.Checkerboard()
+		checker["format"].setValue( GafferImage.Format( 4096, 2160 ) )
+
+		node = GafferImage.Blur()
+		node["in"].setInput( checker["out"] )
+		node["radius"].setValue( imath.V2f( 20 ) )
+
+		# Exclude the generation of the input
+		# from our measurements.
+		Gaffer.ValuePlug.clearCache()
+		GafferImageTest.processTiles( checker["out"] )
+
+		with GafferTest.TestRunner.PerformanceScope() :
+			GafferImageTest.processTiles( node["out"] )
+
 if __name__ == "__main__":
 	unittest.main()
@@ -42,6 +42,7 @@ import imath
 import IECore
 
 import Gaffer
+import GafferTest
 import GafferImage
 import GafferImageTest
 
@@ -248,3 +249,23 @@ class GradeTest( GafferImageTest.ImageTestCase ) :
 
 		sampler["channels"].setValue( IECore.StringVectorData( [ "B.R", "B.G", "B.B", "B.A" ] ) )
 		self.assertEqual( sampler["color"].getValue(), imath.Color4f( 1 ) )
+
+	@GafferTest.TestRunner.PerformanceTestMethod()
+	def testChainPerformance( self ) :
+
+		constant = GafferImage.Constant()
+		constant["format"].setValue( GafferImage.Format( 4096, 2160 ) )
+		constant["color"].setValue( imath.Color4f( 0.5 ) )
+
+		out = constant["out"]
+		grades = []
+		for i in range( 0, 20 ) :
+			grade = GafferImage.Grade()
+			grade["in"].setInput( out )
+			grade["gain"].setValue( imath.Color4f( 1 + i / 100.0 ) )
+			grades.append( grade )
+			out = grade["out"]
+
+		Gaffer.ValuePlug.clearCache()
+		with GafferTest.TestRunner.PerformanceScope() :
+			GafferImageTest.processTiles( out )
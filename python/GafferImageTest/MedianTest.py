@@ -172,5 +172,23 @@ class MedianTest( GafferImageTest.ImageTestCase ) :
 		bt.cancelAndWait()
 		self.assertLess( time.time() - t, acceptableCancellationDelay )
 
+	@GafferTest.TestRunner.PerformanceTestMethod()
+	def testPerformance( self ) :
+
+		checker = GafferImage.Checkerboard()
+		checker["format"].setValue( GafferImage.Format( 4096, 2160 ) )
+
+		node = GafferImage.Median()
+		node["in"].setInput( checker["out"] )
+		node["radius"].setValue( imath.V2i( 3 ) )
+
+		# Exclude the generation of the input
+		# from our measurements.
+		Gaffer.ValuePlug.clearCache()
+		GafferImageTest.processTiles( checker["out"] )
+
+		with GafferTest.TestRunner.PerformanceScope() :
+			GafferImageTest.processTiles( node["out"] )
+
 if __name__ == "__main__":
 	unittest.main()
@@ -211,5 +211,24 @@ class ResampleTest( GafferImageTest.ImageTestCase ) :
 		bt.cancelAndWait()
 		self.assertLess( time.time() - t, acceptableCancellationDelay )
 
+	@GafferTest.TestRunner.PerformanceTestMethod()
+	def testPerformance( self ) :
+
+		checker = GafferImage.Checkerboard()
+		checker["format"].setValue( GafferImage.Format( 4096, 2160 ) )
+
+		node = GafferImage.Resample()
+		node["in"].setInput( checker["out"] )
+		node["matrix"].setValue( imath.M33f().scale( imath.V2f( 0.5 ) ) )
+		node["filter"].setValue( "lanczos3" )
+
+		# Exclude the generation of the input
+		# from our measurements.
+		Gaffer.ValuePlug.clearCache()
+		GafferImageTest.processTiles( checker["out"] )
+
+		with GafferTest.TestRunner.PerformanceScope() :
+			GafferImageTest.processTiles( node["out"] )
+
 if __name__ == "__main__":
 	unittest.main()
@@ -294,3 +294,43 @@ class EvaluateLightLinksTest( GafferSceneTest.SceneTestCase ) :
 			set( evalNode["out"].attributes( '/group/lightFilter' )["filteredLights"] ),
 			{ '/group/group/light', '/group/group/light1' }
 		)
+
+	def testLightNamesSharedBetweenLocations( self ) :
+
+		sphere = GafferScene.Sphere()
+
+		duplicate = GafferScene.Duplicate()
+		duplicate["in"].setInput( sphere["out"] )
+		duplicate["target"].setValue( "/sphere" )
+		duplicate["copies"].setValue( 99 )
+
+		pathFilter = GafferScene.PathFilter()
+		pathFilter["paths"].setValue( IECore.StringVectorData( [ "/*" ] ) )
+
+		attributes = GafferScene.StandardAttributes()
+		attributes["in"].setInput( duplicate["out"] )
+		attributes["filter"].setInput( pathFilter["out"] )
+		attributes["attributes"]["linkedLights"]["enabled"].setValue( True )
+		attributes["attributes"]["linkedLights"]["value"].setValue( "/group/light" )
+
+		light = GafferSceneTest.TestLight()
+
+		group = GafferScene.Group()
+		group["in"][0].setInput( attributes["out"] )
+		group["in"][1].setInput( light["out"] )
+
+		evalNode = GafferScene.EvaluateLightLinks()
+		evalNode["in"].setInput( group["out"] )
+
+		paths = [ "/group/" + str( n ) for n in duplicate["out"].childNames( "/" ) ]
+		self.assertEqual( len( paths ), 100 )
+
+		Gaffer.ValuePlug.clearCache()
+		with Gaffer.PerformanceMonitor() as m :
+			for path in paths :
+				self.assertEqual( set( evalNode["out"].attributes( path )["linkedLights"] ), { "/group/light" } )
+
+		# The light names are evaluated once for the expression shared by
+		# all the spheres, rather than once per sphere.
+		self.assertEqual( m.plugStatistics( evalNode["__lightNames"] ).hashCount, 1 )
+		self.assertEqual( m.plugStatistics( evalNode["__lightNames"] ).computeCount, 1 )
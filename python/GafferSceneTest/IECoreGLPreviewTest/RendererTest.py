@@ -224,7 +224,233 @@ class RendererTest( GafferTest.TestCase ) :
 			)
 		)
 
+		o.transform(
+			imath.M44f().translate( imath.V3f( 2 ) )
+		)
+
+		self.assertEqual(
+			renderer.command( "gl:queryBound", {} ),
+			imath.Box3f(
+				cube.bound().min() + imath.V3f( 2 ),
+				cube.bound().max() + imath.V3f( 2 )
+			)
+		)
+
 		del o
 
+	def testLevelOfDetail( self ) :
+
+		def render( options ) :
+
+			renderer = GafferScene.Private.IECoreScenePreview.Renderer.create( "OpenGL" )
+			for name, value in options.items() :
+				renderer.option( name, value )
+
+			fileName = self.temporaryDirectory() + "/testLevelOfDetail.exr"
+			renderer.output( "test", IECoreScene.Output( fileName, "exr", "rgba", {} ) )
+
+			renderer.object(
+				"sphere",
+				IECoreScene.SpherePrimitive(),
+				renderer.attributes( IECore.CompoundObject() )
+			).transform(
+				imath.M44f().translate( imath.V3f( 0, 0, -5 ) )
+			)
+
+			# An object in front of the camera, at the same depth as the
+			# sphere, but off to the side and outside the frustum. This
+			# should be culled.
+			renderer.object(
+				"culledSphere",
+				IECoreScene.SpherePrimitive(),
+				renderer.attributes( IECore.CompoundObject() )
+			).transform(
+				imath.M44f().translate( imath.V3f( 20, 0, -5 ) )
+			)
+
+			renderer.render()
+
+			image = IECore.Reader.create( fileName ).read()
+			dimensions = image.dataWindow.size() + imath.V2i( 1 )
+			alpha = image["A"][dimensions.x * int( dimensions.y * 0.5 ) + int( dimensions.x * 0.5 )]
+
+			return alpha, renderer.command( "gl:queryRenderStatistics", {} )
+
+		def statistics( culled, drawn, bounds ) :
+
+			return IECore.CompoundData( {
+				"objectsCulled" : IECore.UInt64Data( culled ),
+				"objectsDrawn" : IECore.UInt64Data( drawn ),
+				"boundsDrawn" : IECore.UInt64Data( bounds ),
+			} )
+
+		with IECore.CapturingMessageHandler() as handler :
+
+			# At full detail, the sphere covers the centre of the image.
+			# With culling on, the sphere outside the frustum isn't drawn.
+			self.assertEqual( render( { "gl:culling" : IECore.BoolData( True ) } ), ( 1, statistics( 1, 1, 0 ) ) )
+			self.assertEqual( render( { "gl:culling" : IECore.BoolData( False ) } ), ( 1, statistics( 0, 2, 0 ) ) )
+
+			# When drawn as a bounding box, it doesn't.
+			self.assertEqual( render( { "gl:lod:minimumScreenSize" : IECore.FloatData( 100000 ) } ), ( 0, statistics( 1, 0, 1 ) ) )
+
+			# Generous budgets don't reduce detail.
+			self.assertEqual( render( { "gl:frameBudget" : IECore.FloatData( 10 ) } ), ( 1, statistics( 1, 1, 0 ) ) )
+
+		self.assertEqual( len( handler.messages ), 0 )
+
+	def testRepeatedGeometry( self ) :
+
+		# Objects sharing geometry and attributes are drawn in groups
+		# with a single state binding. Check that each object still
+		# gets its own transform, and that the states for different
+		# groups don't leak into one another.
+
+		renderer = GafferScene.Private.IECoreScenePreview.Renderer.create( "OpenGL" )
+		fileName = self.temporaryDirectory() + "/testRepeatedGeometry.exr"
+		renderer.output( "test", IECoreScene.Output( fileName, "exr", "rgba", {} ) )
+
+		def attributes( color ) :
+
+			return renderer.attributes(
+				IECore.CompoundObject( {
+					"gl:surface" : IECoreScene.ShaderNetwork(
+						shaders = {
+							"output" : IECoreScene.Shader(
+								"color",
+								"surface",
+								{
+									"gl:fragmentSource" : "uniform vec3 colorValue; void main() { gl_FragColor = vec4( colorValue, 1 ); }",
+									"colorValue" : color
+								}
+							)
+						},
+						output = "output"
+					)
+				} )
+			)
+
+		red = attributes( imath.Color3f( 1, 0, 0 ) )
+		green = attributes( imath.Color3f( 0, 1, 0 ) )
+
+		sphere = IECoreScene.SpherePrimitive( 0.05 )
+		objects = []
+		for i in range( -4, 5 ) :
+			o = renderer.object( "/sphere%d" % i, sphere, red if i % 2 else green )
+			o.transform( imath.M44f().translate( imath.V3f( i * 0.2, 0, -5 ) ) )
+			objects.append( o )
+
+		renderer.render()
+
+		image = IECore.Reader.create( fileName ).read()
+		dimensions = image.dataWindow.size() + imath.V2i( 1 )
+
+		# Scan along the middle row of the image, recording the
+		# colour of each sphere we pass through.
+
+		colors = []
+		inside = False
+		for x in range( 0, dimensions.x ) :
+			index = dimensions.x * int( dimensions.y * 0.5 ) + x
+			if image["A"][index] == 0 :
+				inside = False
+				continue
+			if not inside :
+				colors.append( imath.Color3f( image["R"][index], image["G"][index], image["B"][index] ) )
+				inside = True
+
+		self.assertEqual(
+			colors,
+			[ imath.Color3f( 1, 0, 0 ) if i % 2 else imath.Color3f( 0, 1, 0 ) for i in range( -4, 5 ) ]
+		)
+
+	def testQueryRenderComplete( self ) :
+
+		renderer = GafferScene.Private.IECoreScenePreview.Renderer.create(
+			"OpenGL",
+			GafferScene.Private.IECoreScenePreview.Renderer.RenderType.Interactive
+		)
+		self.assertEqual( renderer.command( "gl:queryRenderComplete", {} ), IECore.BoolData( True ) )
+
+	def testFrameBudgetRefinement( self ) :
+
+		renderer = GafferScene.Private.IECoreScenePreview.Renderer.create(
+			"OpenGL",
+			GafferScene.Private.IECoreScenePreview.Renderer.RenderType.Interactive
+		)
+		renderer.option( "gl:culling", IECore.BoolData( False ) )
+		# A budget too small for more than one object to be drawn
+		# in full on each frame.
+		renderer.option( "gl:frameBudget", IECore.FloatData( 1e-9 ) )
+
+		attributes = renderer.attributes( IECore.CompoundObject() )
+		objects = []
+		for i in range( 0, 10 ) :
+			o = renderer.object( "sphere{}".format( i ), IECoreScene.SpherePrimitive( 0.05 ), attributes )
+			o.transform( imath.M44f().translate( imath.V3f( -0.5 + i * 0.1, 0, 0 ) ) )
+			objects.append( o )
+
+		# The first frame draws most objects as bounding boxes,
+		# and reports that it is incomplete.
+
+		renderer.render()
+		self.assertEqual( renderer.command( "gl:queryRenderComplete", {} ), IECore.BoolData( False ) )
+		statistics = renderer.command( "gl:queryRenderStatistics", {} )
+		self.assertGreater( statistics["boundsDrawn"].value, 0 )
+		self.assertEqual( statistics["objectsDrawn"].value + statistics["boundsDrawn"].value, 10 )
+
+		# Subsequent frames of the same view draw more objects in
+		# full, until eventually they all are.
+
+		for i in range( 0, 10 ) :
+			previousBoundsDrawn = renderer.command( "gl:queryRenderStatistics", {} )["boundsDrawn"].value
+			renderer.render()
+			if renderer.command( "gl:queryRenderComplete", {} ).value :
+				break
+			self.assertLess( renderer.command( "gl:queryRenderStatistics", {} )["boundsDrawn"].value, previousBoundsDrawn )
+
+		self.assertEqual( renderer.command( "gl:queryRenderComplete", {} ), IECore.BoolData( True ) )
+		self.assertEqual(
+			renderer.command( "gl:queryRenderStatistics", {} ),
+			IECore.CompoundData( {
+				"objectsCulled" : IECore.UInt64Data( 0 ),
+				"objectsDrawn" : IECore.UInt64Data( 10 ),
+				"boundsDrawn" : IECore.UInt64Data( 0 ),
+			} )
+		)
+
+	def testReleaseObjectsDuringTimeSlicedUpdate( self ) :
+
+		renderer = GafferScene.Private.IECoreScenePreview.Renderer.create(
+			"OpenGL",
+			GafferScene.Private.IECoreScenePreview.Renderer.RenderType.Interactive
+		)
+		# A budget small enough that each render applies only
+		# a slice of the queued edits.
+		renderer.option( "gl:frameBudget", IECore.FloatData( 1e-6 ) )
+
+		attributes = renderer.attributes( IECore.CompoundObject() )
+		objects = [
+			renderer.object( "sphere{}".format( i ), IECoreScene.SpherePrimitive(), attributes )
+			for i in range( 0, 5000 )
+		]
+
+		# Queue edits behind the creation of all the objects, and then
+		# release the objects while the edits are still pending.
+		for i, o in enumerate( objects ) :
+			o.transform( imath.M44f().translate( imath.V3f( i, 0, -5 ) ) )
+		del objects
+
+		renderer.render()
+		self.assertEqual( renderer.command( "gl:queryRenderComplete", {} ), IECore.BoolData( False ) )
+
+		for i in range( 0, 1000 ) :
+			renderer.render()
+			if renderer.command( "gl:queryRenderComplete", {} ).value :
+				break
+
+		self.assertEqual( renderer.command( "gl:queryRenderComplete", {} ), IECore.BoolData( True ) )
+		self.assertEqual( renderer.command( "gl:queryBound", {} ), IECore.Box3fData() )
+
 if __name__ == "__main__":
 	unittest.main()
@@ -0,0 +1,182 @@
+##########################################################################
+#
+#  Copyright (c) 2019, Image Engine Design Inc. All rights reserved.
+#
+#  Redistribution and use in source and binary forms, with or without
+#  modification, are permitted provided that the following conditions are
+#  met:
+#
+#      * Redistributions of source code must retain the above
+#        copyright notice, this list of conditions and the following
+#        disclaimer.
+#
+#      * Redistributions in binary form must reproduce the above
+#        copyright notice, this list of conditions and the following
+#        disclaimer in the documentation and/or other materials provided with
+#        the distribution.
+#
+#      * Neither the name of John Haddon nor the names of
+#        any other contributors to this software may be used to endorse or
+#        promote products derived from this software without specific prior
+#        written permission.
+#
+#  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+#  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+#  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+#  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+#  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+#  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+#  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+#  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+#  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+#  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+#  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#
+##########################################################################
+
+
+import os
+import unittest
+import imath
+
+import IECore
+import IECoreScene
+
+import Gaffer
+import GafferTest
+import GafferScene
+import GafferSceneTest
+
+class NullRendererTest( GafferTest.TestCase ) :
+
+	def testFactory( self ) :
+
+		self.assertTrue( "Null" in GafferScene.Private.IECoreScenePreview.Renderer.types() )
+
+		r = GafferScene.Private.IECoreScenePreview.Renderer.create( "Null" )
+		self.assertTrue( isinstance( r, GafferScene.Private.IECoreScenePreview.Renderer ) )
+		self.assertEqual( r.name(), "Null" )
+
+	def testStatistics( self ) :
+
+		r = GafferScene.Private.IECoreScenePreview.Renderer.create( "Null" )
+
+		r.option( "test:option", IECore.IntData( 10 ) )
+		a = r.attributes( IECore.CompoundObject( { "test:attribute" : IECore.IntData( 1 ) } ) )
+
+		sphere = IECoreScene.SpherePrimitive()
+		o1 = r.object( "/sphere1", sphere, a )
+		o1.transform( imath.M44f().translate( imath.V3f( 1, 0, 0 ) ) )
+		o2 = r.object( "/sphere2", [ sphere, sphere ], [ 0, 1 ], a )
+		o2.transform( [ imath.M44f(), imath.M44f() ], [ 0, 1 ] )
+		o2.attributes( a )
+
+		s = r.command( "null:statistics", {} )
+		self.assertEqual( s["options"].value, 1 )
+		self.assertEqual( s["attributes"].value, 1 )
+		self.assertEqual( s["objects"].value, 2 )
+		self.assertEqual( s["objectSamples"].value, 3 )
+		self.assertEqual( s["transforms"].value, 2 )
+		self.assertEqual( s["transformSamples"].value, 3 )
+		self.assertEqual( s["attributeEdits"].value, 1 )
+		self.assertEqual( s["objectBytes"].value, 3 * sphere.memoryUsage() )
+		self.assertGreater( s["time"].value, 0 )
+
+		# Unknown commands are ignored, rather than being an error.
+		self.assertEqual( r.command( "test:command", {} ), None )
+
+		# Time stops at the first render, and isn't extended by
+		# subsequent ones.
+		r.render()
+		time = r.command( "null:statistics", {} )["time"].value
+		r.render()
+		self.assertEqual( r.command( "null:statistics", {} )["time"].value, time )
+
+		del o1, o2, a
+
+	def testShaders( self ) :
+
+		r = GafferScene.Private.IECoreScenePreview.Renderer.create( "Null" )
+
+		network = IECoreScene.ShaderNetwork(
+			shaders = {
+				"surface" : IECoreScene.Shader( "flat", "test:surface", { "Cs" : imath.Color3f( 1, 0, 0 ) } )
+			},
+			output = "surface"
+		)
+
+		# Networks shared between attributes should only be
+		# hashed and converted once.
+
+		attributes = [
+			r.attributes( IECore.CompoundObject( { "test:surface" : network, "test:index" : IECore.IntData( i ) } ) )
+			for i in range( 0, 10 )
+		]
+
+		s = r.command( "null:statistics", {} )
+		self.assertEqual( s["shaderLookups"].value, 10 )
+		self.assertEqual( s["shaderHashes"].value, 1 )
+		self.assertEqual( s["shaders"].value, 1 )
+
+		# Distinct but identical networks need hashing
+		# separately, but are still only converted once.
+
+		attributes.append( r.attributes( IECore.CompoundObject( { "test:surface" : network.copy() } ) ) )
+
+		s = r.command( "null:statistics", {} )
+		self.assertEqual( s["shaderLookups"].value, 11 )
+		self.assertEqual( s["shaderHashes"].value, 2 )
+		self.assertEqual( s["shaders"].value, 1 )
+
+		# A different network needs converting.
+
+		network2 = IECoreScene.ShaderNetwork(
+			shaders = {
+				"surface" : IECoreScene.Shader( "flat", "test:surface", { "Cs" : imath.Color3f( 0, 1, 0 ) } )
+			},
+			output = "surface"
+		)
+		attributes.append( r.attributes( IECore.CompoundObject( { "test:surface" : network2 } ) ) )
+
+		s = r.command( "null:statistics", {} )
+		self.assertEqual( s["shaders"].value, 2 )
+
+		del attributes
+
+	def testSceneDescription( self ) :
+
+		s = Gaffer.ScriptNode()
+
+		s["sphere"] = GafferScene.Sphere()
+		s["group"] = GafferScene.Group()
+		for i in range( 0, 10 ) :
+			s["group"]["in"][i].setInput( s["sphere"]["out"] )
+
+		s["render"] = GafferScene.Render()
+		s["render"]["in"].setInput( s["group"]["out"] )
+		s["render"]["renderer"].setValue( "Null" )
+		s["render"]["mode"].setValue( s["render"].Mode.SceneDescriptionMode )
+
+		s["render"]["fileName"].setValue( os.path.join( self.temporaryDirectory(), "test1.txt" ) )
+		s["render"]["task"].execute()
+
+		with open( os.path.join( self.temporaryDirectory(), "test1.txt" ) ) as f :
+			records = f.readlines()
+
+		objectRecords = [ r for r in records if r.startswith( "object " ) ]
+		self.assertEqual( len( objectRecords ), 10 )
+		self.assertTrue( any( r.startswith( "object /group/sphere7 " ) for r in objectRecords ) )
+		self.assertEqual( len( [ r for r in records if r.startswith( "transform /group/sphere" ) ] ), 10 )
+
+		# Records are sorted, so that they can be compared between runs.
+
+		self.assertEqual( records, sorted( records ) )
+
+		s["render"]["fileName"].setValue( os.path.join( self.temporaryDirectory(), "test2.txt" ) )
+		s["render"]["task"].execute()
+
+		with open( os.path.join( self.temporaryDirectory(), "test2.txt" ) ) as f :
+			self.assertEqual( f.readlines(), records )
+
+if __name__ == "__main__":
+	unittest.main()
@@ -987,5 +987,25 @@ class InstancerTest( GafferSceneTest.SceneTestCase ) :
 
 		self.assertEqual( instancer["out"].set( "A" ).value.paths(), [ "/plane" ] )
 
+	@GafferTest.TestRunner.PerformanceTestMethod( repeat = 1 )
+	def testMillionPointsPerformance( self ) :
+
+		plane = GafferScene.Plane()
+		plane["divisions"].setValue( imath.V2i( 999 ) )
+
+		sphere = GafferScene.Sphere()
+
+		instancer = GafferScene.Instancer()
+		instancer["in"].setInput( plane["out"] )
+		instancer["instances"].setInput( sphere["out"] )
+		instancer["parent"].setValue( "/plane" )
+
+		# Make sure we don't measure the generation
+		# of the plane itself.
+		plane["out"].object( "/plane" )
+
+		with GafferTest.TestRunner.PerformanceScope() :
+			GafferSceneTest.traverseScene( instancer["out"] )
+
 if __name__ == "__main__":
 	unittest.main()
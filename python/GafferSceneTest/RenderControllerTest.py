@@ -37,6 +37,7 @@
 import unittest
 
 import IECore
+import IECoreScene
 
 import Gaffer
 import GafferScene
@@ -203,5 +204,173 @@ class RenderControllerTest( GafferSceneTest.SceneTestCase ) :
 			lightSet["out"].bound( "/" )
 		)
 
+	def __hintTestScene( self ) :
+
+		s = Gaffer.ScriptNode()
+
+		s["sphere"] = GafferScene.Sphere()
+		s["group"] = GafferScene.Group()
+		for i in range( 0, 20 ) :
+			s["group"]["in"][i].setInput( s["sphere"]["out"] )
+
+		s["filter"] = GafferScene.PathFilter()
+		s["filter"]["paths"].setValue( IECore.StringVectorData( [ "/group/sphere3" ] ) )
+
+		s["attributes"] = GafferScene.StandardAttributes()
+		s["attributes"]["in"].setInput( s["group"]["out"] )
+		s["attributes"]["filter"].setInput( s["filter"]["out"] )
+		s["attributes"]["attributes"]["transformBlur"]["enabled"].setValue( True )
+
+		s["set"] = GafferScene.Set()
+		s["set"]["in"].setInput( s["attributes"]["out"] )
+		s["set"]["name"].setValue( "render:test" )
+		s["set"]["paths"].setValue( IECore.StringVectorData( [ "/group/sphere1" ] ) )
+
+		s["attributes2"] = GafferScene.StandardAttributes()
+		s["attributes2"]["in"].setInput( s["set"]["out"] )
+		s["attributes2"]["filter"].setInput( s["filter"]["out"] )
+		s["attributes2"]["attributes"]["doubleSided"]["enabled"].setValue( True )
+
+		renderer = GafferScene.Private.IECoreScenePreview.Renderer.create(
+			"Null",
+			GafferScene.Private.IECoreScenePreview.Renderer.RenderType.Interactive
+		)
+		controller = GafferScene.RenderController( s["attributes2"]["out"], Gaffer.Context(), renderer )
+		controller.setMinimumExpansionDepth( 3 )
+		controller.update()
+
+		return s, controller
+
+	def testAffectedPathsHint( self ) :
+
+		s, controller = self.__hintTestScene()
+		renderer = controller.renderer()
+
+		def attributeEdits() :
+			return renderer.command( "null:statistics", {} )["attributeEdits"].value
+
+		# Edits to a SceneElementProcessor immediately upstream
+		# of the render should only visit the filtered locations.
+
+		edits = attributeEdits()
+		with Gaffer.PerformanceMonitor() as m :
+			s["attributes2"]["attributes"]["doubleSided"]["value"].setValue( False )
+			controller.update()
+
+		self.assertLess( m.plugStatistics( s["attributes2"]["out"]["attributes"] ).hashCount, 5 )
+		self.assertEqual( attributeEdits(), edits + 1 )
+
+		# Edits further upstream require a full update, because we
+		# can't know which locations they affect.
+
+		edits = attributeEdits()
+		with Gaffer.PerformanceMonitor() as m :
+			s["attributes"]["attributes"]["transformBlur"]["value"].setValue( False )
+			controller.update()
+
+		self.assertGreaterEqual( m.plugStatistics( s["attributes2"]["out"]["attributes"] ).hashCount, 20 )
+		self.assertEqual( attributeEdits(), edits + 1 )
+
+		# As do edits to the filter, because we don't know what
+		# was matched previously.
+
+		edits = attributeEdits()
+		with Gaffer.PerformanceMonitor() as m :
+			s["filter"]["paths"].setValue( IECore.StringVectorData( [ "/group/sphere5" ] ) )
+			controller.update()
+
+		self.assertGreaterEqual( m.plugStatistics( s["attributes2"]["out"]["attributes"] ).hashCount, 20 )
+		self.assertEqual( attributeEdits(), edits + 2 )
+
+	def testRenderSetsMembershipUpdate( self ) :
+
+		s, controller = self.__hintTestScene()
+		renderer = controller.renderer()
+
+		def attributeEdits() :
+			return renderer.command( "null:statistics", {} )["attributeEdits"].value
+
+		# Only the locations whose membership changed should be edited.
+
+		edits = attributeEdits()
+		s["set"]["paths"].setValue( IECore.StringVectorData( [ "/group/sphere2" ] ) )
+		controller.update()
+		self.assertEqual( attributeEdits(), edits + 2 )
+
+		edits = attributeEdits()
+		s["set"]["paths"].setValue( IECore.StringVectorData( [ "/group" ] ) )
+		controller.update()
+		self.assertEqual( attributeEdits(), edits + 20 )
+
+	def testPriorityCamera( self ) :
+
+		s = Gaffer.ScriptNode()
+
+		s["big"] = GafferScene.Sphere()
+		s["big"]["name"].setValue( "big" )
+		s["big"]["transform"]["translate"]["z"].setValue( -5 )
+
+		s["small"] = GafferScene.Sphere()
+		s["small"]["radius"].setValue( 0.01 )
+		s["small"]["transform"]["translate"]["z"].setValue( -5 )
+
+		s["smallGroup"] = GafferScene.Group()
+		s["smallGroup"]["name"].setValue( "smallGroup" )
+		for i in range( 0, 10 ) :
+			s["smallGroup"]["in"][i].setInput( s["small"]["out"] )
+
+		s["group"] = GafferScene.Group()
+		s["group"]["in"][0].setInput( s["big"]["out"] )
+		s["group"]["in"][1].setInput( s["smallGroup"]["out"] )
+
+		renderer = GafferScene.Private.IECoreScenePreview.Renderer.create(
+			"Null",
+			GafferScene.Private.IECoreScenePreview.Renderer.RenderType.Interactive
+		)
+		controller = GafferScene.RenderController( s["group"]["out"], Gaffer.Context(), renderer )
+		controller.setMinimumExpansionDepth( 3 )
+
+		camera = IECoreScene.Camera()
+		camera.setProjection( "perspective" )
+		controller.setPriorityCamera( camera )
+		self.assertEqual( controller.getPriorityCamera(), camera )
+
+		# Cumulative counts of objects, transform edits and attribute
+		# edits, recorded at the end of each update pass.
+		objectCounts = []
+		def callback( status ) :
+			if status == Gaffer.BackgroundTask.Status.Completed :
+				statistics = renderer.command( "null:statistics", {} )
+				objectCounts.append( (
+					statistics["objects"].value,
+					statistics["transforms"].value,
+					statistics["attributeEdits"].value,
+				) )
+
+		# The big sphere fills much of the view, so should be output
+		# before the small ones. The second pass must not send the big
+		# sphere's transform or attributes again.
+
+		controller.updateInBackground( callback ).wait()
+		self.assertEqual( objectCounts, [ ( 1, 1, 0 ), ( 11, 11, 0 ) ] )
+
+		# Nothing needs updating, so there is no need to
+		# prioritise anything.
+
+		del objectCounts[:]
+		controller.updateInBackground( callback ).wait()
+		self.assertEqual( objectCounts, [ ( 11, 11, 0 ) ] )
+
+		# Without a priority camera, everything is output in
+		# a single pass.
+
+		controller.setPriorityCamera( None )
+		self.assertEqual( controller.getPriorityCamera(), None )
+
+		del objectCounts[:]
+		s["small"]["radius"].setValue( 0.02 )
+		controller.updateInBackground( callback ).wait()
+		self.assertEqual( objectCounts, [ ( 21, 21, 0 ) ] )
+
 if __name__ == "__main__":
 	unittest.main()
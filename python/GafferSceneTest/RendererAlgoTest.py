@@ -35,9 +35,11 @@
 ##########################################################################
 
 import unittest
+import imath
 
 import IECore
 
+import Gaffer
 import GafferScene
 import GafferSceneTest
 
@@ -75,6 +77,110 @@ class RendererAlgoTest( GafferSceneTest.SceneTestCase ) :
 		self.assertScenesEqual( defaultAdaptors["out"], defaultAdaptors2["out"] )
 		self.assertSceneHashesEqual( defaultAdaptors["out"], defaultAdaptors2["out"] )
 
+	def testObjectSamples( self ) :
+
+		script = Gaffer.ScriptNode()
+		script["sphere"] = GafferScene.Sphere()
+		script["expression"] = Gaffer.Expression()
+		script["expression"].setExpression( 'parent["sphere"]["radius"] = context.getFrame()' )
+
+		with Gaffer.Context() as c :
+
+			c.setFrame( 1 )
+			c["scene:path"] = IECore.InternedStringVectorData( [ "sphere" ] )
+
+			samples, times = GafferScene.objectSamples( script["sphere"]["out"], 2, imath.V2f( 0.75, 1.25 ) )
+			self.assertEqual( times, [ 0.75, 1, 1.25 ] )
+			self.assertEqual( [ s.radius() for s in samples ], [ 0.75, 1, 1.25 ] )
+
+			# Samples should collapse to a single one when the object isn't
+			# deforming.
+
+			script["expression"].setExpression( 'parent["sphere"]["radius"] = 2' )
+			samples, times = GafferScene.objectSamples( script["sphere"]["out"], 2, imath.V2f( 0.75, 1.25 ) )
+			self.assertEqual( times, [] )
+			self.assertEqual( [ s.radius() for s in samples ], [ 2 ] )
+
+			# And when we're not sampling motion at all.
+
+			samples, times = GafferScene.objectSamples( script["sphere"]["out"], 0, imath.V2f( 0.75, 1.25 ) )
+			self.assertEqual( times, [] )
+			self.assertEqual( [ s.radius() for s in samples ], [ 2 ] )
+
+	def testIdenticalObjectSamplesComputedOnce( self ) :
+
+		# Switch between two static spheres part way through the shutter.
+		# The output object hash doesn't depend on the frame, so repeats
+		# across the samples taken from the same sphere.
+
+		script = Gaffer.ScriptNode()
+
+		script["sphere1"] = GafferScene.Sphere()
+		script["sphere1"]["radius"].setValue( 1 )
+
+		script["sphere2"] = GafferScene.Sphere()
+		script["sphere2"]["radius"].setValue( 2 )
+
+		script["switch"] = Gaffer.Switch()
+		script["switch"].setup( GafferScene.ScenePlug() )
+		script["switch"]["in"][0].setInput( script["sphere1"]["out"] )
+		script["switch"]["in"][1].setInput( script["sphere2"]["out"] )
+
+		script["expression"] = Gaffer.Expression()
+		script["expression"].setExpression( 'parent["switch"]["index"] = 0 if context.getFrame() < 1.1 else 1' )
+
+		# Disable the cache, so that repeated samples would be computed
+		# again if they were requested again.
+		cacheMemoryLimit = Gaffer.ValuePlug.getCacheMemoryLimit()
+		Gaffer.ValuePlug.setCacheMemoryLimit( 0 )
+		try :
+
+			with Gaffer.Context() as c :
+
+				c.setFrame( 1 )
+				c["scene:path"] = IECore.InternedStringVectorData( [ "sphere" ] )
+
+				with Gaffer.PerformanceMonitor() as m :
+					samples, times = GafferScene.objectSamples( script["switch"]["out"], 4, imath.V2f( 0.75, 1.25 ) )
+
+		finally :
+
+			Gaffer.ValuePlug.setCacheMemoryLimit( cacheMemoryLimit )
+
+		# Identical samples should only be computed once, but
+		# should still be output in order.
+
+		self.assertEqual( times, [ 0.75, 0.875, 1, 1.125, 1.25 ] )
+		self.assertEqual( [ s.radius() for s in samples ], [ 1, 1, 1, 2, 2 ] )
+		self.assertEqual( m.plugStatistics( script["switch"]["out"]["object"] ).computeCount, 2 )
+
+	def testTransformSamples( self ) :
+
+		script = Gaffer.ScriptNode()
+		script["sphere"] = GafferScene.Sphere()
+		script["expression"] = Gaffer.Expression()
+		script["expression"].setExpression( 'parent["sphere"]["transform"]["translate"]["x"] = context.getFrame()' )
+
+		with Gaffer.Context() as c :
+
+			c.setFrame( 1 )
+			c["scene:path"] = IECore.InternedStringVectorData( [ "sphere" ] )
+
+			samples, times = GafferScene.transformSamples( script["sphere"]["out"], 2, imath.V2f( 0.75, 1.25 ) )
+			self.assertEqual( times, [ 0.75, 1, 1.25 ] )
+			self.assertEqual( [ s.translation().x for s in samples ], [ 0.75, 1, 1.25 ] )
+
+			# Rigid motion shouldn't result in multiple object samples.
+
+			samples, times = GafferScene.objectSamples( script["sphere"]["out"], 2, imath.V2f( 0.75, 1.25 ) )
+			self.assertEqual( times, [] )
+			self.assertEqual( len( samples ), 1 )
+
+			script["expression"].setExpression( 'parent["sphere"]["transform"]["translate"]["x"] = 1' )
+			samples, times = GafferScene.transformSamples( script["sphere"]["out"], 2, imath.V2f( 0.75, 1.25 ) )
+			self.assertEqual( times, [] )
+			self.assertEqual( samples, [ imath.M44f().translate( imath.V3f( 1, 0, 0 ) ) ] )
+
 	def tearDown( self ) :
 
 		GafferSceneTest.SceneTestCase.tearDown( self )
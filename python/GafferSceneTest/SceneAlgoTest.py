@@ -40,6 +40,7 @@ import imath
 import IECore
 
 import Gaffer
+import GafferTest
 import GafferScene
 import GafferSceneTest
 
@@ -483,5 +484,46 @@ class SceneAlgoTest( GafferSceneTest.SceneTestCase ) :
 			len( instancer["out"].childNames( "/plane/instances/sphere" ) ) + 4,
 		)
 
+	def __deepAndWideScene( self, depth, width ) :
+
+		# Builds a hierarchy `depth` levels deep, with `width`
+		# children at every level.
+
+		result = []
+		scene = GafferScene.Sphere()
+		result.append( scene )
+		for i in range( 0, depth ) :
+
+			duplicate = GafferScene.Duplicate()
+			duplicate["in"].setInput( scene["out"] )
+			duplicate["target"].setValue( "/" + scene["out"].childNames( "/" )[0] )
+			duplicate["copies"].setValue( width - 1 )
+
+			group = GafferScene.Group()
+			group["in"][0].setInput( duplicate["out"] )
+
+			result.extend( [ duplicate, group ] )
+			scene = group
+
+		return result
+
+	@GafferTest.TestRunner.PerformanceTestMethod()
+	def testParallelTraverseDeepHierarchyPerformance( self ) :
+
+		nodes = self.__deepAndWideScene( depth = 16, width = 2 )
+
+		Gaffer.ValuePlug.clearCache()
+		with GafferTest.TestRunner.PerformanceScope() :
+			GafferSceneTest.traverseScene( nodes[-1]["out"] )
+
+	@GafferTest.TestRunner.PerformanceTestMethod()
+	def testParallelTraverseWideHierarchyPerformance( self ) :
+
+		nodes = self.__deepAndWideScene( depth = 2, width = 300 )
+
+		Gaffer.ValuePlug.clearCache()
+		with GafferTest.TestRunner.PerformanceScope() :
+			GafferSceneTest.traverseScene( nodes[-1]["out"] )
+
 if __name__ == "__main__":
 	unittest.main()
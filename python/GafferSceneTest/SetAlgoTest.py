@@ -147,6 +147,38 @@ class SetAlgoTest( GafferSceneTest.SceneTestCase ) :
 		setA["paths"].setValue( IECore.StringVectorData( [ '/group/sphere1' ] ) )
 		self.assertNotEqual( h, GafferScene.SetAlgo.setExpressionHash( "setA", group2["out"] ) )
 
+	def testRepeatedEvaluation( self ) :
+
+		sphere = GafferScene.Sphere()
+		sphere["sets"].setValue( "setA" )
+
+		group = GafferScene.Group()
+		group["in"][0].setInput( sphere["out"] )
+
+		setB = GafferScene.Set()
+		setB["in"].setInput( group["out"] )
+		setB["name"].setValue( "setB" )
+
+		# Parsed expressions are reused, but results must
+		# still reflect the current contents of the sets.
+
+		for i in range( 0, 2 ) :
+			self.assertCorrectEvaluation( setB["out"], "setA | setB", [ "/group/sphere" ] )
+			self.assertCorrectEvaluation( setB["out"], "setA - setB", [ "/group/sphere" ] )
+
+		setB["paths"].setValue( IECore.StringVectorData( [ "/group" ] ) )
+		self.assertCorrectEvaluation( setB["out"], "setA | setB", [ "/group", "/group/sphere" ] )
+		self.assertCorrectEvaluation( setB["out"], "setA - setB", [ "/group/sphere" ] )
+		self.assertCorrectEvaluation( setB["out"], "setB - setA", [ "/group" ] )
+
+		# And syntax errors must be reported every time.
+
+		for i in range( 0, 2 ) :
+			with self.assertRaisesRegexp( RuntimeError, "Syntax error" ) :
+				GafferScene.SetAlgo.evaluateSetExpression( "setA - (setB", setB["out"] )
+			with self.assertRaisesRegexp( RuntimeError, "Syntax error" ) :
+				GafferScene.SetAlgo.setExpressionHash( "setA - (setB", setB["out"] )
+
 	def testColonAndDotInSetAndObjectNames( self ):
 
 		sphere1 = GafferScene.Sphere( "Sphere1" )
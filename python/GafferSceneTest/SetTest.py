@@ -199,6 +199,18 @@ class SetTest( GafferSceneTest.SceneTestCase ) :
 		s["paths"].setValue( IECore.StringVectorData( [ "/a/b*" ] ) )
 		self.assertRaises( RuntimeError, s["out"].set, "set" )
 
+	def testManyPaths( self ) :
+
+		paths = [ "/group{0}/object{1}".format( i, j ) for i in range( 0, 100 ) for j in range( 0, 100 ) ]
+
+		s = GafferScene.Set()
+		s["paths"].setValue( IECore.StringVectorData( paths + [ "" ] ) )
+
+		self.assertEqual( s["out"].set( "set" ).value, IECore.PathMatcher( paths ) )
+
+		s["paths"].setValue( IECore.StringVectorData( paths + [ "/group50/*" ] ) )
+		self.assertRaises( RuntimeError, s["out"].set, "set" )
+
 	def testEmptyStringIsIgnored( self ) :
 
 		s1 = GafferScene.Set()
@@ -519,6 +519,42 @@ class AnimationTest( GafferTest.TestCase ) :
 		self.assertEqual( k.getTime(), 0 )
 		self.assertIn( s["n"]["op1"], { x[0] for x in cs } )
 
+	def testEvaluateAfterEdits( self ) :
+
+		s = Gaffer.ScriptNode()
+		s["n"] = GafferTest.AddNode()
+		curve = Gaffer.Animation.acquire( s["n"]["op1"] )
+
+		self.assertEqual( curve.evaluate( 0 ), 0 )
+
+		k = Gaffer.Animation.Key( 0, 1, Gaffer.Animation.Type.Linear )
+		curve.addKey( k )
+		curve.addKey( Gaffer.Animation.Key( 2, 3, Gaffer.Animation.Type.Linear ) )
+		self.assertEqual( curve.evaluate( 1 ), 2 )
+
+		with Gaffer.UndoScope( s ) :
+			k.setValue( 3 )
+		self.assertEqual( curve.evaluate( 1 ), 3 )
+
+		with Gaffer.UndoScope( s ) :
+			k.setTime( 1 )
+		self.assertEqual( curve.evaluate( 0 ), 3 )
+		self.assertEqual( curve.evaluate( 1.5 ), 3 )
+
+		s.undo()
+		self.assertEqual( curve.evaluate( 1 ), 3 )
+		self.assertEqual( curve.evaluate( -1 ), 3 )
+
+		s.undo()
+		self.assertEqual( curve.evaluate( 1 ), 2 )
+
+		with Gaffer.UndoScope( s ) :
+			curve.removeKey( k )
+		self.assertEqual( curve.evaluate( 0 ), 3 )
+
+		s.undo()
+		self.assertEqual( curve.evaluate( 0 ), 1 )
+
 	def testModifyKeyReplacesExistingKey( self ) :
 
 		s = Gaffer.ScriptNode()
@@ -676,5 +676,34 @@ class DependencyNodeTest( GafferTest.TestCase ) :
 		self.assertEqual( mh.messages[0].context, "BadAffects::affects()" )
 		self.assertEqual( mh.messages[0].message, "TypeError: No registered converter was able to extract a C++ reference to type Gaffer::Plug from this Python object of type NoneType\n" )
 
+	@GafferTest.TestRunner.PerformanceTestMethod()
+	def testDirtyPropagationPerformance( self ) :
+
+		# A grid of nodes where each node depends on two nodes
+		# from the previous row, so that dirtiness fans out
+		# widely from any single input.
+
+		s = Gaffer.ScriptNode()
+
+		previousRow = [ GafferTest.AddNode() for i in range( 0, 50 ) ]
+		for n in previousRow :
+			s.addChild( n )
+
+		for row in range( 0, 50 ) :
+			currentRow = []
+			for column in range( 0, 50 ) :
+				n = GafferTest.AddNode()
+				n["op1"].setInput( previousRow[column]["sum"] )
+				n["op2"].setInput( previousRow[(column+1) % 50]["sum"] )
+				s.addChild( n )
+				currentRow.append( n )
+			previousRow = currentRow
+
+		firstRow = [ n for n in s.children( GafferTest.AddNode ) ][:50]
+		with GafferTest.TestRunner.PerformanceScope() :
+			for i in range( 0, 10 ) :
+				for n in firstRow :
+					n["op1"].setValue( i )
+
 if __name__ == "__main__":
 	unittest.main()
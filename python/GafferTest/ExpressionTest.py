@@ -1416,5 +1416,40 @@ class ExpressionTest( GafferTest.TestCase ) :
 			self.assertEqual( s["n"]["op1"].getValue(), 0 )
 			self.assertEqual( s["n"]["op2"].getValue(), 1 )
 
+	def testExecutionSharedBetweenUnusedContextVariables( self ) :
+
+		s = Gaffer.ScriptNode()
+		s["n"] = GafferTest.AddNode()
+
+		# The expression doesn't use `context["i"]`, so concurrent
+		# computes in contexts which differ only by that variable
+		# should collaborate on a single execution. The sleep gives
+		# the other threads time to arrive while the execution is
+		# in progress.
+		s["e"] = Gaffer.Expression()
+		s["e"].setExpression( 'import time; time.sleep( 0.1 ); parent["n"]["op1"] = context.getFrame()' )
+
+		Gaffer.ValuePlug.clearCache()
+		with Gaffer.PerformanceMonitor() as m :
+			GafferTest.parallelGetValue( s["n"]["sum"], 1000, "i" )
+
+		self.assertEqual( m.plugStatistics( s["e"]["__execute"] ).computeCount, 1 )
+
+	@GafferTest.TestRunner.PerformanceTestMethod()
+	def testEvaluationPerformance( self ) :
+
+		s = Gaffer.ScriptNode()
+		s["n"] = GafferTest.AddNode()
+
+		s["e"] = Gaffer.Expression()
+		s["e"].setExpression( 'parent["n"]["op1"] = int( context["i"] ) + context.getFrame()' )
+
+		Gaffer.ValuePlug.clearCache()
+		with GafferTest.TestRunner.PerformanceScope() :
+			with Gaffer.Context() as c :
+				for i in range( 0, 10000 ) :
+					c["i"] = i
+					s["n"]["sum"].getValue()
+
 if __name__ == "__main__":
 	unittest.main()
@@ -961,6 +961,52 @@ class GraphComponentTest( GafferTest.TestCase ) :
 		self.assertEqual( len( c.parentChanges ), 1 )
 		self.assertEqual( c.parentChanges[-1], ( None, None ) )
 
+	def testManyChildren( self ) :
+
+		g = Gaffer.GraphComponent()
+		for i in range( 0, 100 ) :
+			g.addChild( Gaffer.GraphComponent( "a" ) )
+
+		self.assertEqual( [ c.getName() for c in g ], [ "a" ] + [ "a" + str( i ) for i in range( 1, 100 ) ] )
+		for c in g :
+			self.assertTrue( g[c.getName()].isSame( c ) )
+			self.assertTrue( g.descendant( c.getName() ).isSame( c ) )
+
+		# Renaming
+
+		c = g["a50"]
+		c.setName( "b" )
+		self.assertNotIn( "a50", g )
+		self.assertTrue( g["b"].isSame( c ) )
+
+		c.setName( "a10" )
+		self.assertEqual( c.getName(), "a100" )
+		self.assertTrue( g["a100"].isSame( c ) )
+
+		c.setName( "a99" )
+		self.assertEqual( c.getName(), "a100" )
+
+		# Removal
+
+		g.removeChild( g["a99"] )
+		g.removeChild( c )
+		self.assertNotIn( "a99", g )
+		self.assertNotIn( "a100", g )
+
+		g.addChild( Gaffer.GraphComponent( "a" ) )
+		self.assertEqual( g[-1].getName(), "a99" )
+		self.assertTrue( g["a99"].isSame( g[-1] ) )
+
+		g.addChild( Gaffer.GraphComponent( "a1somethingElse" ) )
+		self.assertEqual( g[-1].getName(), "a1somethingElse" )
+
+		# Reparenting
+
+		h = Gaffer.GraphComponent()
+		h.addChild( g["a20"] )
+		self.assertNotIn( "a20", g )
+		self.assertEqual( h["a20"].getName(), "a20" )
+
 	@GafferTest.TestRunner.PerformanceTestMethod()
 	def testMakeNamesUnique( self ) :
 
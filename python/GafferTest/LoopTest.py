@@ -199,6 +199,26 @@ class LoopTest( GafferTest.TestCase ) :
 		self.assertIsInstance( n["previous"], Gaffer.StringPlug )
 		self.assertIsInstance( n["next"], Gaffer.StringPlug )
 
+	def testManyIterations( self ) :
+
+		s = Gaffer.ScriptNode()
+
+		s["n"] = self.intLoop()
+		s["a"] = GafferTest.AddNode()
+
+		s["n"]["in"].setValue( 0 )
+		s["n"]["next"].setInput( s["a"]["sum"] )
+		s["a"]["op1"].setInput( s["n"]["previous"] )
+		s["a"]["op2"].setValue( 1 )
+
+		s["n"]["iterations"].setValue( 5000 )
+
+		with Gaffer.PerformanceMonitor() as m :
+			self.assertEqual( s["n"]["out"].getValue(), 5000 )
+
+		# Each iteration should be computed only once.
+		self.assertEqual( m.plugStatistics( s["a"]["sum"] ).computeCount, 5000 )
+
 	def testSerialisationUsesSetup( self ) :
 
 		s1 = Gaffer.ScriptNode()
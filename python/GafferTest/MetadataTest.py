@@ -1157,6 +1157,33 @@ class MetadataTest( GafferTest.TestCase ) :
 		self.assertEqual( Gaffer.Metadata.value( n["user"]["p"]["r"], "testPlugAncestor" ), 10 )
 		self.assertIn( "testPlugAncestor", Gaffer.Metadata.registeredValues( n["user"]["p"]["r"] ) )
 
+	def testRegistrationAfterLookup( self ) :
+
+		n = GafferTest.AddNode()
+		self.assertEqual( Gaffer.Metadata.value( n, "testLookup" ), None )
+		self.assertEqual( Gaffer.Metadata.value( n["op1"], "testLookup" ), None )
+
+		Gaffer.Metadata.registerValue( Gaffer.Node, "testLookup", 1 )
+		Gaffer.Metadata.registerValue( Gaffer.Node, "op*", "testLookup", 2 )
+		self.assertEqual( Gaffer.Metadata.value( n, "testLookup" ), 1 )
+		self.assertEqual( Gaffer.Metadata.value( n["op1"], "testLookup" ), 2 )
+
+		Gaffer.Metadata.registerValue( GafferTest.AddNode, "testLookup", 3 )
+		Gaffer.Metadata.registerValue( GafferTest.AddNode, "op1", "testLookup", 4 )
+		self.assertEqual( Gaffer.Metadata.value( n, "testLookup" ), 3 )
+		self.assertEqual( Gaffer.Metadata.value( n["op1"], "testLookup" ), 4 )
+		self.assertEqual( Gaffer.Metadata.value( n["op2"], "testLookup" ), 2 )
+
+		Gaffer.Metadata.deregisterValue( GafferTest.AddNode, "testLookup" )
+		Gaffer.Metadata.deregisterValue( GafferTest.AddNode, "op1", "testLookup" )
+		self.assertEqual( Gaffer.Metadata.value( n, "testLookup" ), 1 )
+		self.assertEqual( Gaffer.Metadata.value( n["op1"], "testLookup" ), 2 )
+
+		Gaffer.Metadata.deregisterValue( Gaffer.Node, "testLookup" )
+		Gaffer.Metadata.deregisterValue( Gaffer.Node, "op*", "testLookup" )
+		self.assertEqual( Gaffer.Metadata.value( n, "testLookup" ), None )
+		self.assertEqual( Gaffer.Metadata.value( n["op1"], "testLookup" ), None )
+
 	def testValueFromNoneRaises( self ) :
 
 		with self.assertRaisesRegexp( Exception, "did not match C\+\+ signature" ) :
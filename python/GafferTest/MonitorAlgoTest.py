@@ -91,5 +91,29 @@ class MonitorAlgoTest( GafferTest.TestCase ) :
 			"Hashes per compute : 1.5"
 		)
 
+	def testFormatTraceStatistics( self ) :
+
+		s = Gaffer.ScriptNode()
+		s["n1"] = GafferTest.AddNode()
+		s["n2"] = GafferTest.AddNode()
+		s["n2"]["op1"].setInput( s["n1"]["sum"] )
+
+		with Gaffer.TraceMonitor() as m :
+			s["n2"]["sum"].getValue()
+
+		f = Gaffer.MonitorAlgo.formatStatistics( m )
+		self.assertIn( "TraceMonitor Summary", f )
+		self.assertIn( "Average parallelism", f )
+		self.assertIn( "Critical path", f )
+
+		# Everything happened on a single thread, so all the time
+		# is serial, and both nodes are on the critical path.
+		self.assertIn( "nodes by serial time", f )
+		self.assertIn( "nodes by critical path time", f )
+		self.assertIn( "n1", f )
+		self.assertIn( "n2", f )
+
+		self.assertNotIn( "n2", Gaffer.MonitorAlgo.formatStatistics( m, maxLinesPerMetric = 0 ) )
+
 if __name__ == "__main__":
 	unittest.main()
@@ -1464,5 +1464,43 @@ class ScriptNodeTest( GafferTest.TestCase ) :
 		s["fileName"].setValue( self.temporaryDirectory() + "/test2.gfr" )
 		self.assertFalse( Gaffer.MetadataAlgo.getReadOnly( s ) )
 
+	def __largeScript( self, numNodes ) :
+
+		s = Gaffer.ScriptNode()
+		for i in range( 0, numNodes // 10 ) :
+			s["b%d" % i] = Gaffer.Box()
+			previous = None
+			for j in range( 0, 9 ) :
+				n = GafferTest.AddNode()
+				if previous is not None :
+					n["op1"].setInput( previous["sum"] )
+				n["op2"].setValue( j )
+				s["b%d" % i].addChild( n )
+				previous = n
+
+		return s
+
+	@GafferTest.TestRunner.PerformanceTestMethod()
+	def testSavePerformance( self ) :
+
+		s = self.__largeScript( 10000 )
+		s["fileName"].setValue( os.path.join( self.temporaryDirectory(), "large.gfr" ) )
+
+		with GafferTest.TestRunner.PerformanceScope() :
+			s.save()
+
+	@GafferTest.TestRunner.PerformanceTestMethod()
+	def testLoadPerformance( self ) :
+
+		s = self.__largeScript( 10000 )
+		s["fileName"].setValue( os.path.join( self.temporaryDirectory(), "large.gfr" ) )
+		s.save()
+
+		s2 = Gaffer.ScriptNode()
+		s2["fileName"].setValue( s["fileName"].getValue() )
+
+		with GafferTest.TestRunner.PerformanceScope() :
+			s2.load()
+
 if __name__ == "__main__":
 	unittest.main()
@@ -57,10 +57,11 @@ class TestRunner( unittest.TextTestRunner ) :
 	# Decorator used to annotate tests which measure performance.
 	class PerformanceTestMethod( object ) :
 
-		def __init__( self, repeat = 3, acceptableDifference = 0.01 ) :
+		def __init__( self, repeat = 3, acceptableDifference = 0.01, acceptableMemoryDifference = 10 * 1024 * 1024 ) :
 
 			self.__repeat = repeat
 			self.__acceptableDifference = acceptableDifference
+			self.__acceptableMemoryDifference = acceptableMemoryDifference
 
 		# Called to return the decorated method.
 		def __call__( self, method ) :
@@ -69,28 +70,109 @@ class TestRunner( unittest.TextTestRunner ) :
 			def wrapper( *args, **kw ) :
 
 				timings = []
+				memory = None
 				for i in range( 0, self.__repeat ) :
+					TestRunner.PerformanceScope._timing = None
+					TestRunner.PerformanceScope._memory = None
+					m = TestRunner._MemoryMeasurement()
 					t = time.time()
 					result = method( *args, **kw )
-					timings.append( time.time() - t )
-
-				# Stash timings so they can be recovered
-				# by TestRunner.__Result.
+					t = time.time() - t
+					m = m.finish()
+					# If the test used a PerformanceScope, then only
+					# the code inside the scope is measured.
+					if TestRunner.PerformanceScope._timing is not None :
+						t = TestRunner.PerformanceScope._timing
+					if TestRunner.PerformanceScope._memory is not None :
+						m = TestRunner.PerformanceScope._memory
+					timings.append( t )
+					if m is not None :
+						memory = m if memory is None else min( memory, m )
+
+				# Stash timings and memory usage so they can
+				# be recovered by TestRunner.__Result.
 				args[0].timings = timings
+				args[0].memory = memory
 
-				# If previous timings are available, then
-				# compare against them and throw if a regression
+				# If previous timings and memory usage are available,
+				# then compare against them and throw if a regression
 				# is detected.
 				previousTimings = getattr( args[0], "previousTimings" )
 				if previousTimings :
 					args[0].assertLessEqual( min( timings ), min( previousTimings ) + self.__acceptableDifference )
 
+				previousMemory = getattr( args[0], "previousMemory", None )
+				if memory is not None and previousMemory is not None :
+					args[0].assertLessEqual( memory, previousMemory + self.__acceptableMemoryDifference )
+
 				return result
 
 			wrapper.performanceTestMethod = True
 
 			return wrapper
 
+	# Context manager used within a PerformanceTestMethod to limit
+	# timing and memory measurement to a particular block of code. This
+	# allows expensive setup to be excluded from the measurements.
+	class PerformanceScope( object ) :
+
+		_timing = None
+		_memory = None
+
+		def __enter__( self ) :
+
+			self.__memory = TestRunner._MemoryMeasurement()
+			self.__startTime = time.time()
+
+		def __exit__( self, type, value, traceBack ) :
+
+			TestRunner.PerformanceScope._timing = time.time() - self.__startTime
+			TestRunner.PerformanceScope._memory = self.__memory.finish()
+
+	# Measures the peak memory used by a block of code, in bytes, over and
+	# above the memory the process was already using when it started. The
+	# process-wide peak reported by `getrusage()` can't be used for this,
+	# because it only ever grows, so we reset the peak for each measurement
+	# using the `/proc` interface. Where that isn't available, `finish()`
+	# returns None and memory is not measured.
+	class _MemoryMeasurement( object ) :
+
+		def __init__( self ) :
+
+			self.__startRSS = None
+			try :
+				with open( "/proc/self/clear_refs", "w" ) as f :
+					f.write( "5" )
+			except ( IOError, OSError ) :
+				return
+
+			self.__startRSS = self.__status( "VmRSS" )
+
+		def finish( self ) :
+
+			if self.__startRSS is None :
+				return None
+
+			peakRSS = self.__status( "VmHWM" )
+			if peakRSS is None :
+				return None
+
+			return max( peakRSS - self.__startRSS, 0 )
+
+		@staticmethod
+		def __status( field ) :
+
+			try :
+				with open( "/proc/self/status" ) as f :
+					for line in f :
+						if line.startswith( field + ":" ) :
+							# Values are reported in kB
+							return int( line.split()[1] ) * 1024
+			except ( IOError, OSError ) :
+				pass
+
+			return None
+
 	def run( self, test ) :
 
 		result = unittest.TextTestRunner.run( self, test )
@@ -162,6 +244,7 @@ class TestRunner( unittest.TextTestRunner ) :
 
 			previousResults = self.__previousResults.get( str( test ), {} )
 			test.previousTimings = previousResults.get( "timings", [] )
+			test.previousMemory = previousResults.get( "memory", None )
 
 			unittest.TextTestResult.startTest( self, test )
 
@@ -209,4 +292,8 @@ class TestRunner( unittest.TextTestRunner ) :
 			if timings :
 				d["timings"] = timings
 
+			memory = getattr( test, "memory", None )
+			if memory is not None :
+				d["memory"] = memory
+
 			self.__results[str(test)] = d
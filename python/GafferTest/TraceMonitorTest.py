@@ -0,0 +1,208 @@
+##########################################################################
+#
+#  Copyright (c) 2019, Image Engine Design Inc. All rights reserved.
+#
+#  Redistribution and use in source and binary forms, with or without
+#  modification, are permitted provided that the following conditions are
+#  met:
+#
+#      * Redistributions of source code must retain the above
+#        copyright notice, this list of conditions and the following
+#        disclaimer.
+#
+#      * Redistributions in binary form must reproduce the above
+#        copyright notice, this list of conditions and the following
+#        disclaimer in the documentation and/or other materials provided with
+#        the distribution.
+#
+#      * Neither the name of John Haddon nor the names of
+#        any other contributors to this software may be used to endorse or
+#        promote products derived from this software without specific prior
+#        written permission.
+#
+#  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+#  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+#  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+#  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+#  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+#  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+#  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+#  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+#  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+#  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+#  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#
+##########################################################################
+
+
+import os
+import gc
+import json
+import unittest
+
+import IECore
+
+import Gaffer
+import GafferTest
+
+class TraceMonitorTest( GafferTest.TestCase ) :
+
+	def setUp( self ) :
+
+		GafferTest.TestCase.setUp( self )
+
+		# Clean up any garbage from previous tests, so that the
+		# hash cache isn't cleared unexpectedly during a test.
+		# See PerformanceMonitorTest for more details.
+		IECore.RefCounted.collectGarbage()
+		while gc.collect() :
+			pass
+
+	def testEvents( self ) :
+
+		a = GafferTest.AddNode()
+		a["op1"].setValue( 1 )
+		a["op2"].setValue( 2 )
+
+		with Gaffer.TraceMonitor() as m :
+			self.assertEqual( a["sum"].getValue(), 3 )
+
+		events = m.events()
+		self.assertEqual( [ e.type for e in events ], [ "computeNode:hash", "computeNode:compute" ] )
+
+		for e in events :
+			self.assertTrue( e.plug.isSame( a["sum"] ) )
+			self.assertEqual( e.contextHash, Gaffer.Context.current().hash() )
+			self.assertGreaterEqual( e.start, 0 )
+			self.assertGreaterEqual( e.duration, 0 )
+
+		self.assertLessEqual( events[0].start, events[1].start )
+		self.assertEqual( events[0].threadIndex, events[1].threadIndex )
+		self.assertEqual( m.numDiscardedEvents(), 0 )
+
+		# Cache hits don't launch processes, so don't
+		# generate events.
+
+		with m :
+			self.assertEqual( a["sum"].getValue(), 3 )
+
+		self.assertEqual( len( m.events() ), 2 )
+
+	def testNestedEvents( self ) :
+
+		a1 = GafferTest.AddNode()
+		a2 = GafferTest.AddNode()
+		a2["op1"].setInput( a1["sum"] )
+
+		with Gaffer.TraceMonitor() as m :
+			a2["sum"].getValue()
+
+		events = { ( e.plug.fullName(), e.type ) : e for e in m.events() }
+		outer = events[( a2["sum"].fullName(), "computeNode:compute" )]
+		inner = events[( a1["sum"].fullName(), "computeNode:compute" )]
+
+		self.assertGreaterEqual( inner.start, outer.start )
+		self.assertLessEqual( inner.start + inner.duration, outer.start + outer.duration )
+
+	def testParent( self ) :
+
+		a1 = GafferTest.AddNode()
+		a2 = GafferTest.AddNode()
+		a2["op1"].setInput( a1["sum"] )
+
+		with Gaffer.TraceMonitor() as m :
+			a2["sum"].getValue()
+
+		events = m.events()
+		indices = { ( e.plug.fullName(), e.type ) : i for i, e in enumerate( events ) }
+
+		for plug in ( a1["sum"], a2["sum"] ) :
+			# Hashes are launched by the compute for the
+			# same plug, or directly by `getValue()`.
+			self.assertIn(
+				events[indices[( plug.fullName(), "computeNode:hash" )]].parent,
+				{ None, indices[( a2["sum"].fullName(), "computeNode:compute" )] }
+			)
+
+		self.assertEqual(
+			events[indices[( a1["sum"].fullName(), "computeNode:compute" )]].parent,
+			indices[( a2["sum"].fullName(), "computeNode:compute" )]
+		)
+		self.assertIsNone( events[indices[( a2["sum"].fullName(), "computeNode:compute" )]].parent )
+
+	def testMaxEventsPerThread( self ) :
+
+		a = GafferTest.AddNode()
+
+		with Gaffer.TraceMonitor( maxEventsPerThread = 3 ) as m :
+			for i in range( 0, 10 ) :
+				with Gaffer.Context() as c :
+					c["i"] = i
+					a["sum"].getValue()
+
+		# Each iteration performs a hash, but only the first
+		# performs a compute.
+		self.assertEqual( len( m.events() ), 3 )
+		self.assertEqual( m.numDiscardedEvents(), 8 )
+		self.assertEqual( [ e.type for e in m.events() ], [ "computeNode:hash" ] * 3 )
+
+	def testPlugLifetime( self ) :
+
+		a = GafferTest.AddNode()
+		with Gaffer.TraceMonitor() as m :
+			a["sum"].getValue()
+
+		del a
+
+		# The monitor keeps the plugs alive, so events
+		# remain valid.
+		for e in m.events() :
+			self.assertEqual( e.plug.getName(), "sum" )
+
+	def testDiscardedEventsReleasePlugs( self ) :
+
+		a = GafferTest.AddNode()
+		b = GafferTest.AddNode()
+
+		plug = a["sum"]
+		refCount = plug.refCount()
+
+		with Gaffer.TraceMonitor( maxEventsPerThread = 2 ) as m :
+
+			plug.getValue()
+			self.assertEqual( plug.refCount(), refCount + 1 )
+
+			for i in range( 0, 10 ) :
+				with Gaffer.Context() as c :
+					c["i"] = i
+					b["sum"].getValue()
+
+		# All the events for `plug` have been discarded, so
+		# the monitor no longer needs to keep it alive.
+		self.assertEqual( plug.refCount(), refCount )
+		for e in m.events() :
+			self.assertTrue( e.plug.isSame( b["sum"] ) )
+
+	def testWriteTrace( self ) :
+
+		a = GafferTest.AddNode()
+		with Gaffer.TraceMonitor() as m :
+			a["sum"].getValue()
+
+		fileName = os.path.join( self.temporaryDirectory(), "trace.json" )
+		m.writeTrace( fileName )
+
+		with open( fileName ) as f :
+			trace = json.load( f )
+
+		self.assertEqual( len( trace["traceEvents"] ), 2 )
+		for event in trace["traceEvents"] :
+			self.assertEqual( event["name"], a["sum"].fullName() )
+			self.assertEqual( event["ph"], "X" )
+			self.assertEqual( event["args"]["nodeType"], "GafferTest::AddNode" )
+			self.assertIn( event["cat"], { "computeNode:hash", "computeNode:compute" } )
+
+		self.assertRaises( RuntimeError, m.writeTrace, "/this/directory/does/not/exist/trace.json" )
+
+if __name__ == "__main__":
+	unittest.main()
@@ -616,6 +616,52 @@ class ValuePlugTest( GafferTest.TestCase ) :
 		n["user"]["c"].setInput( None )
 		self.assertTrue( n["user"]["c"]["i"].getInput() is None )
 
+	def testCacheStatistics( self ) :
+
+		Gaffer.ValuePlug.setCacheStatisticsEnabled( True )
+		self.assertTrue( Gaffer.ValuePlug.getCacheStatisticsEnabled() )
+
+		Gaffer.ValuePlug.clearCache()
+		Gaffer.ValuePlug.resetCacheStatistics()
+		self.assertEqual( Gaffer.ValuePlug.cacheStatistics(), {} )
+
+		n = GafferTest.AddNode()
+		n["op1"].setValue( 1001 )
+		n["op2"].setValue( 1002 )
+
+		self.assertEqual( n["sum"].getValue(), 2003 )
+		self.assertEqual( n["sum"].getValue(), 2003 )
+
+		key = ( "GafferTest::AddNode", "Gaffer::IntPlug" )
+		statistics = Gaffer.ValuePlug.cacheStatistics()
+		self.assertEqual( statistics.keys(), [ key ] )
+
+		s = statistics[key]
+		self.assertEqual( s.computeMisses, 1 )
+		self.assertEqual( s.computeHits, 1 )
+		self.assertEqual( s.hashMisses, 1 )
+		self.assertEqual( s.hashHits, 1 )
+		self.assertEqual( s.computeEvictions, 0 )
+		self.assertGreater( s.computeMemoryUsage, 0 )
+		self.assertGreaterEqual( s.computeWaitDuration, 0 )
+
+		Gaffer.ValuePlug.clearCache()
+
+		s = Gaffer.ValuePlug.cacheStatistics()[key]
+		self.assertEqual( s.computeEvictions, 1 )
+		self.assertEqual( s.computeMemoryUsage, 0 )
+
+		# Statistics aren't collected when disabled.
+
+		Gaffer.ValuePlug.setCacheStatisticsEnabled( False )
+		self.assertEqual( n["sum"].getValue(), 2003 )
+
+		s = Gaffer.ValuePlug.cacheStatistics()[key]
+		self.assertEqual( s.computeMisses, 1 )
+
+		Gaffer.ValuePlug.resetCacheStatistics()
+		self.assertEqual( Gaffer.ValuePlug.cacheStatistics(), {} )
+
 	@GafferTest.TestRunner.PerformanceTestMethod()
 	def testContentionForOneItem( self ) :
 
@@ -632,6 +678,7 @@ class ValuePlugTest( GafferTest.TestCase ) :
 		GafferTest.TestCase.tearDown( self )
 
 		Gaffer.ValuePlug.setCacheMemoryLimit( self.__originalCacheMemoryLimit )
+		Gaffer.ValuePlug.setCacheStatisticsEnabled( False )
 
 if __name__ == "__main__":
 	unittest.main()
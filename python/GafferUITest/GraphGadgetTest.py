@@ -1393,5 +1393,209 @@ class GraphGadgetTest( GafferUITest.TestCase ) :
 		self.assertEqual( c[0].dstNodule(), g.nodeGadget( s["n2"] ).nodule( s["n2"]["c"]["r"] ) )
 		self.assertIsNone( c[0].srcNodule() )
 
+	def testNodeGadgetsIntersecting( self ) :
+
+		s = Gaffer.ScriptNode()
+		g = GafferUI.GraphGadget( s )
+
+		for x in range( 0, 10 ) :
+			for y in range( 0, 10 ) :
+				n = GafferTest.AddNode( "n{}{}".format( x, y ) )
+				s.addChild( n )
+				g.setNodePosition( n, imath.V2f( x * 100, y * 100 ) )
+
+		def assertNodesIntersecting( region, names ) :
+
+			self.assertEqual(
+				set( n.node().getName() for n in g.nodeGadgetsIntersecting( region ) ),
+				set( names )
+			)
+
+		assertNodesIntersecting( imath.Box2f( imath.V2f( -1000 ), imath.V2f( -500 ) ), [] )
+		assertNodesIntersecting( imath.Box2f( imath.V2f( -1 ), imath.V2f( 1 ) ), [ "n00" ] )
+		assertNodesIntersecting( imath.Box2f( imath.V2f( 90, -1 ), imath.V2f( 210, 101 ) ), [ "n10", "n11", "n20", "n21" ] )
+		assertNodesIntersecting(
+			imath.Box2f( imath.V2f( -1000 ), imath.V2f( 2000 ) ),
+			[ "n{}{}".format( x, y ) for x in range( 0, 10 ) for y in range( 0, 10 ) ]
+		)
+
+		# Moving a node must update the index.
+
+		g.setNodePosition( s["n00"], imath.V2f( 5000, 5000 ) )
+		assertNodesIntersecting( imath.Box2f( imath.V2f( -1 ), imath.V2f( 1 ) ), [] )
+		assertNodesIntersecting( imath.Box2f( imath.V2f( 4999 ), imath.V2f( 5001 ) ), [ "n00" ] )
+
+		# As must removing one.
+
+		del s["n11"]
+		assertNodesIntersecting( imath.Box2f( imath.V2f( 90, -1 ), imath.V2f( 210, 101 ) ), [ "n10", "n20", "n21" ] )
+
+		# And changing the filter.
+
+		g.setFilter( Gaffer.StandardSet( [ s["n10"] ] ) )
+		assertNodesIntersecting( imath.Box2f( imath.V2f( 90, -1 ), imath.V2f( 210, 101 ) ), [ "n10" ] )
+
+	def testOffViewNodeGadgetsNotRendered( self ) :
+
+		class CullingTestNode( GafferTest.AddNode ) :
+
+			def __init__( self, name = "CullingTestNode" ) :
+
+				GafferTest.AddNode.__init__( self, name )
+
+		IECore.registerRunTimeTyped( CullingTestNode )
+
+		class CullingTestNodeGadget( GafferUI.StandardNodeGadget ) :
+
+			def __init__( self, node ) :
+
+				GafferUI.StandardNodeGadget.__init__( self, node )
+
+				self.rendered = False
+
+			def doRenderLayer( self, layer, style ) :
+
+				self.rendered = True
+
+		GafferUI.NodeGadget.registerNodeGadget( CullingTestNode, CullingTestNodeGadget )
+
+		s = Gaffer.ScriptNode()
+		s["n1"] = CullingTestNode()
+		s["n2"] = CullingTestNode()
+
+		g = GafferUI.GraphGadget( s )
+		g.setNodePosition( s["n1"], imath.V2f( 0 ) )
+		g.setNodePosition( s["n2"], imath.V2f( 10000 ) )
+
+		with GafferUI.Window() as w :
+			gw = GafferUI.GadgetWidget( g )
+
+		w.setVisible( True )
+		self.waitForIdle( 1000 )
+
+		g.nodeGadget( s["n1"] ).rendered = False
+		g.nodeGadget( s["n2"] ).rendered = False
+
+		gw.getViewportGadget().frame( imath.Box3f( imath.V3f( -20, -20, 0 ), imath.V3f( 20, 20, 0 ) ) )
+		self.waitForIdle( 1000 )
+
+		self.assertTrue( g.nodeGadget( s["n1"] ).rendered )
+		self.assertFalse( g.nodeGadget( s["n2"] ).rendered )
+
+		# Bringing the other node into view must render it.
+
+		gw.getViewportGadget().frame( imath.Box3f( imath.V3f( 9980, 9980, 0 ), imath.V3f( 10020, 10020, 0 ) ) )
+		self.waitForIdle( 1000 )
+
+		self.assertTrue( g.nodeGadget( s["n2"] ).rendered )
+
+	def testConnectionGadgetAtAfterNodeMove( self ) :
+
+		s = Gaffer.ScriptNode()
+		s["n1"] = GafferTest.AddNode()
+		s["n2"] = GafferTest.AddNode()
+		s["n2"]["op1"].setInput( s["n1"]["sum"] )
+
+		g = GafferUI.GraphGadget( s )
+
+		with GafferUI.Window() as w :
+			gw = GafferUI.GadgetWidget( g )
+
+		w.setVisible( True )
+		self.waitForIdle( 1000 )
+
+		viewport = gw.getViewportGadget()
+		connection = g.connectionGadget( s["n2"]["op1"] )
+
+		def connectionMidpoint() :
+
+			srcP = connection.srcNodule().transformedBound( g ).center()
+			dstP = connection.dstNodule().transformedBound( g ).center()
+			return ( srcP + dstP ) * 0.5
+
+		def assertConnectionAt( position ) :
+
+			line = viewport.rasterToGadgetSpace( viewport.gadgetToRasterSpace( position, g ), g )
+			self.assertTrue( g.connectionGadgetAt( line ).isSame( connection ) )
+
+		# Line the nodules up vertically so that the connection is
+		# straight, and its midpoint lies on it.
+
+		g.setNodePosition( s["n1"], imath.V2f( 0 ) )
+		g.setNodePosition( s["n2"], imath.V2f( 0, -10 ) )
+		offset = connection.srcNodule().transformedBound( g ).center().x - connection.dstNodule().transformedBound( g ).center().x
+		g.setNodePosition( s["n2"], imath.V2f( offset, -10 ) )
+
+		viewport.frame( imath.Box3f( imath.V3f( -30, -50, 0 ), imath.V3f( 30, 10, 0 ) ) )
+		self.waitForIdle( 1000 )
+
+		oldMidpoint = connectionMidpoint()
+		assertConnectionAt( oldMidpoint )
+
+		# Moving the end node must dirty the connection, so that
+		# it is picked at its new location.
+
+		g.setNodePosition( s["n2"], imath.V2f( offset, -40 ) )
+		self.waitForIdle( 1000 )
+
+		newMidpoint = connectionMidpoint()
+		self.assertLess( newMidpoint.y, oldMidpoint.y - 10 )
+		assertConnectionAt( newMidpoint )
+
+	def testRubberBandSelectionOverLargeGrid( self ) :
+
+		s = Gaffer.ScriptNode()
+		g = GafferUI.GraphGadget( s )
+
+		for x in range( 0, 30 ) :
+			for y in range( 0, 30 ) :
+				n = GafferTest.AddNode( "n{}_{}".format( x, y ) )
+				s.addChild( n )
+				g.setNodePosition( n, imath.V2f( x * 40, y * 40 ) )
+
+		with GafferUI.Window() as w :
+			gw = GafferUI.GadgetWidget( g )
+
+		w.setVisible( True )
+		self.waitForIdle( 1000 )
+
+		gw.getViewportGadget().frame( g.bound() )
+		self.waitForIdle( 1000 )
+
+		# Start the drag in empty space between nodes, and end it on
+		# a node centre, so that a row and a column of nodes straddle
+		# the edge of the region and must not be selected.
+
+		region = imath.Box2f( imath.V2f( 220, 260 ), imath.V2f( 600, 720 ) )
+
+		def event( position ) :
+
+			result = GafferUI.DragDropEvent(
+				GafferUI.ButtonEvent.Buttons.Left, GafferUI.ButtonEvent.Buttons.Left,
+				IECore.LineSegment3f( imath.V3f( position.x, position.y, 1 ), imath.V3f( position.x, position.y, -1 ) )
+			)
+			result.sourceGadget = g
+			return result
+
+		self.assertIsNotNone( g.dragBeginSignal()( g, event( region.min() ) ) )
+		self.assertTrue( g.dragEnterSignal()( g, event( region.min() ) ) )
+		g.dragMoveSignal()( g, event( region.center() ) )
+		g.dragMoveSignal()( g, event( region.max() ) )
+		self.assertTrue( g.dragEndSignal()( g, event( region.max() ) ) )
+
+		expected = set()
+		straddling = set()
+		for n in s.children( Gaffer.Node ) :
+			b = g.nodeGadget( n ).transformedBound( g )
+			b = imath.Box2f( imath.V2f( b.min().x, b.min().y ), imath.V2f( b.max().x, b.max().y ) )
+			if region.intersects( b.min() ) and region.intersects( b.max() ) :
+				expected.add( n )
+			elif region.intersects( b ) :
+				straddling.add( n )
+
+		self.assertTrue( len( expected ) )
+		self.assertTrue( len( straddling ) )
+		self.assertEqual( set( s.selection() ), expected )
+
 if __name__ == "__main__":
 	unittest.main()
@@ -317,5 +317,38 @@ class PathListingWidgetTest( GafferUITest.TestCase ) :
 		self.assertEqual( len( s ), 1 )
 		self.assertEqual( str( s[0] ), "/a" )
 
+	def testIncrementalUpdate( self ) :
+
+		d = {
+			"a" : { "e" : 10 },
+			"b" : { "f" : 20 },
+			"c" : { "g" : 30 },
+		}
+
+		p = Gaffer.DictPath( d, "/" )
+		w = GafferUI.PathListingWidget( p, displayMode = GafferUI.PathListingWidget.DisplayMode.Tree )
+		w.setExpansion( IECore.PathMatcher( [ "/a", "/c" ] ) )
+
+		# Remove and add children, both at the root and
+		# beneath an expanded location.
+
+		del d["b"]
+		d["d"] = { "h" : 40 }
+		d["a"]["i"] = 50
+		del d["c"]["g"]
+
+		p.pathChangedSignal()( p )
+		self.waitForIdle( 100 )
+
+		self.assertEqual( w.getExpansion(), IECore.PathMatcher( [ "/a", "/c" ] ) )
+
+		for path in [ "/a", "/a/e", "/a/i", "/c", "/d" ] :
+			w.setSelection( IECore.PathMatcher( [ path ] ), scrollToFirst = False, expandNonLeaf = False )
+			self.assertEqual( w.getSelection(), IECore.PathMatcher( [ path ] ) )
+
+		for path in [ "/b", "/b/f", "/c/g" ] :
+			w.setSelection( IECore.PathMatcher( [ path ] ), scrollToFirst = False, expandNonLeaf = False )
+			self.assertTrue( w.getSelection().isEmpty() )
+
 if __name__ == "__main__":
 	unittest.main()
@@ -899,5 +899,59 @@ class StandardGraphLayoutTest( GafferUITest.TestCase ) :
 		self.assertTrue( expressionPosition.y < i1Bounds.min().y )
 		self.assertTrue( expressionPosition.y > i2Bounds.max().y )
 
+	def testLayoutSubsetOfLargeGraph( self ) :
+
+		s = Gaffer.ScriptNode()
+		g = GafferUI.GraphGadget( s )
+
+		# A large graph of existing nodes, which
+		# shouldn't be moved by the layout.
+
+		existingPositions = {}
+		for x in range( 0, 20 ) :
+			for y in range( 0, 20 ) :
+				n = GafferTest.AddNode()
+				s.addChild( n )
+				existingPositions[n] = imath.V2f( x * 30, y * -15 )
+				g.setNodePosition( n, existingPositions[n] )
+
+		# Some new nodes, all piled on top of each other.
+
+		newNodes = Gaffer.StandardSet()
+		previous = None
+		for i in range( 0, 20 ) :
+			n = GafferTest.AddNode()
+			s.addChild( n )
+			g.setNodePosition( n, imath.V2f( -50, 0 ) )
+			if previous is not None :
+				n["op1"].setInput( previous["sum"] )
+			previous = n
+			newNodes.add( n )
+
+		g.getLayout().layoutNodes( g, newNodes )
+
+		for n, p in existingPositions.items() :
+			self.assertEqual( g.getNodePosition( n ), p )
+
+		self.assertNoOverlaps( g )
+
+	@GafferTest.TestRunner.PerformanceTestMethod()
+	def testLayoutPerformance( self ) :
+
+		s = Gaffer.ScriptNode()
+
+		nodes = []
+		for i in range( 0, 200 ) :
+			n = GafferTest.AddNode()
+			s.addChild( n )
+			if len( nodes ) > 1 :
+				n["op1"].setInput( nodes[-1]["sum"] )
+				n["op2"].setInput( nodes[-2]["sum"] )
+			nodes.append( n )
+
+		g = GafferUI.GraphGadget( s )
+		with GafferTest.TestRunner.PerformanceScope() :
+			g.getLayout().layoutNodes( g )
+
 if __name__ == "__main__":
 	unittest.main()
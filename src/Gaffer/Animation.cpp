@@ -43,6 +43,8 @@
 
 #include "boost/bind.hpp"
 
+#include <algorithm>
+
 using namespace std;
 using namespace Imath;
 using namespace IECore;
@@ -83,7 +85,7 @@ void Animation::Key::setTime( float time )
 						key->m_time = time;
 					}
 				);
-				curve->propagateDirtiness( curve->outPlug() );
+				curve->keysChanged();
 			},
 			// Undo
 			[ curve, previousTime, time ] {
@@ -93,7 +95,7 @@ void Animation::Key::setTime( float time )
 						key->m_time = previousTime;
 					}
 				);
-				curve->propagateDirtiness( curve->outPlug() );
+				curve->keysChanged();
 			}
 		);
 	}
@@ -119,12 +121,12 @@ void Animation::Key::setValue( float value )
 			// Do
 			[ k, value ] {
 				k->m_value = value;
-				k->m_parent->propagateDirtiness( k->m_parent->outPlug() );
+				k->m_parent->keysChanged();
 			},
 			// Undo
 			[ k, previousValue ] {
 				k->m_value = previousValue;
-				k->m_parent->propagateDirtiness( k->m_parent->outPlug() );
+				k->m_parent->keysChanged();
 			}
 		);
 	}
@@ -150,12 +152,12 @@ void Animation::Key::setType( Type type )
 			// Do
 			[ k, type ] {
 				k->m_value = type;
-				k->m_parent->propagateDirtiness( k->m_parent->outPlug() );
+				k->m_parent->keysChanged();
 			},
 			// Undo
 			[ k, previousType ] {
 				k->m_type = previousType;
-				k->m_parent->propagateDirtiness( k->m_parent->outPlug() );
+				k->m_parent->keysChanged();
 			}
 		);
 	}
@@ -195,7 +197,7 @@ const Animation::CurvePlug *Animation::Key::parent() const
 IE_CORE_DEFINERUNTIMETYPED( Animation::CurvePlug );
 
 Animation::CurvePlug::CurvePlug( const std::string &name, Direction direction, unsigned flags )
-	:	ValuePlug( name, direction, flags & ~Plug::AcceptsInputs )
+	:	ValuePlug( name, direction, flags & ~Plug::AcceptsInputs ), m_evaluationDataDirty( false )
 {
 	addChild( new FloatPlug( "out", Plug::Out ) );
 }
@@ -222,13 +224,13 @@ void Animation::CurvePlug::addKey( const KeyPtr &key )
 		[this, key] {
 			m_keys.insert( key );
 			key->m_parent = this;
-			propagateDirtiness( outPlug() );
+			keysChanged();
 		},
 		// Undo
 		[this, key] {
 			m_keys.erase( key->getTime() );
 			key->m_parent = nullptr;
-			propagateDirtiness( outPlug() );
+			keysChanged();
 		}
 	);
 }
@@ -271,13 +273,13 @@ void Animation::CurvePlug::removeKey( const KeyPtr &key )
 		[ this, key ] {
 			m_keys.erase( key->getTime() );
 			key->m_parent = nullptr;
-			propagateDirtiness( outPlug() );
+			keysChanged();
 		},
 		// Undo
 		[ this, key ] {
 			m_keys.insert( key );
 			key->m_parent = this;
-			propagateDirtiness( outPlug() );
+			keysChanged();
 		}
 	);
 }
@@ -379,38 +381,74 @@ Animation::ConstKeyIterator Animation::CurvePlug::end() const
 
 float Animation::CurvePlug::evaluate( float time ) const
 {
-	if( m_keys.empty() )
+	updateEvaluationData();
+
+	if( m_times.empty() )
 	{
 		return 0;
 	}
 
-	Keys::const_iterator rightIt = m_keys.lower_bound( time );
-	if( rightIt == m_keys.end() )
+	auto rightIt = std::lower_bound( m_times.begin(), m_times.end(), time );
+	if( rightIt == m_times.end() )
 	{
-		return (*m_keys.rbegin())->getValue();
+		return m_values.back();
 	}
 
-	const Key &right = **rightIt;
-	if( right.getTime() == time || rightIt == m_keys.begin() )
+	const size_t right = rightIt - m_times.begin();
+	if( *rightIt == time || right == 0 )
 	{
-		return right.getValue();
+		return m_values[right];
 	}
 
-	const Key &left = **std::prev( rightIt );
-	if( right.getType() == Linear )
+	const size_t left = right - 1;
+	if( m_types[right] == Linear )
 	{
-		const float t = ( time - left.getTime() ) / ( right.getTime() - left.getTime() );
-		return Imath::lerp( left.getValue(), right.getValue(), t );
+		const float t = ( time - m_times[left] ) / ( m_times[right] - m_times[left] );
+		return Imath::lerp( m_values[left], m_values[right], t );
 	}
 	else
 	{
 		// Step. We already dealt with the case where we're
 		// exactly at the time of the right keyframe, so we
 		// just return the value of the left keyframe.
-		return left.getValue();
+		return m_values[left];
+	}
+}
+
+void Animation::CurvePlug::keysChanged()
+{
+	m_evaluationDataDirty = true;
+	propagateDirtiness( outPlug() );
+}
+
+void Animation::CurvePlug::updateEvaluationData() const
+{
+	if( !m_evaluationDataDirty )
+	{
+		return;
+	}
+
+	tbb::spin_mutex::scoped_lock lock( m_evaluationDataMutex );
+	if( !m_evaluationDataDirty )
+	{
+		// Another thread got here first.
+		return;
+	}
+
+	m_times.clear();
+	m_values.clear();
+	m_types.clear();
+	m_times.reserve( m_keys.size() );
+	m_values.reserve( m_keys.size() );
+	m_types.reserve( m_keys.size() );
+	for( const auto &key : m_keys )
+	{
+		m_times.push_back( key->m_time );
+		m_values.push_back( key->m_value );
+		m_types.push_back( key->m_type );
 	}
 
-	return 0;
+	m_evaluationDataDirty = false;
 }
 
 FloatPlug *Animation::CurvePlug::outPlug()
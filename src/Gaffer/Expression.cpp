@@ -386,6 +386,22 @@ void Expression::compute( ValuePlug *output, const Context *context ) const
 	ComputeNode::compute( output, context );
 }
 
+ValuePlug::CachePolicy Expression::computeCachePolicy( const Gaffer::ValuePlug *output ) const
+{
+	if( output == executePlug() )
+	{
+		// Our hash only includes the context variables the expression
+		// actually reads, so many contexts can share a single execution.
+		// When those contexts are being evaluated concurrently (typically
+		// one per scene location), we want the other threads to wait for
+		// that execution rather than run the engine themselves. The engine
+		// may pull on upstream plugs that spawn tasks, so we must allow
+		// the waiting threads to collaborate on them.
+		return ValuePlug::CachePolicy::TaskCollaboration;
+	}
+	return ComputeNode::computeCachePolicy( output );
+}
+
 void Expression::updatePlugs( const std::vector<ValuePlug *> &inPlugs, const std::vector<ValuePlug *> &outPlugs )
 {
 	for( size_t i = 0, e = inPlugs.size(); i < e; ++i )
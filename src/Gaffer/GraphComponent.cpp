@@ -48,7 +48,9 @@
 #include "boost/lexical_cast.hpp"
 #include "boost/regex.hpp"
 
+#include <cctype>
 #include <set>
+#include <unordered_map>
 
 using namespace Gaffer;
 using namespace IECore;
@@ -85,6 +87,137 @@ struct GraphComponent::Signals : boost::noncopyable
 
 };
 
+//////////////////////////////////////////////////////////////////////////
+// GraphComponent::NameIndex
+//
+// Name lookups are linear searches over the children, which is fine for
+// typical numbers of children but makes loading or pasting large numbers
+// of nodes quadratic. So once a GraphComponent has enough children, we
+// maintain an index from name to child. We also track the numeric suffixes
+// in use for each name prefix, so that unique names can be generated
+// without visiting every sibling.
+//////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+const size_t g_nameIndexThreshold = 32;
+
+struct InternedStringHash
+{
+	size_t operator()( const InternedString &s ) const
+	{
+		// InternedStrings are unique, so we can hash the address.
+		return std::hash<const char *>()( s.c_str() );
+	}
+};
+
+// Splits `name` into a prefix and a numeric suffix in the same way
+// that `setName()` considers siblings. Returns 0 if there is no suffix.
+long splitNumericSuffix( const std::string &name, std::string &prefix )
+{
+	size_t i = name.size();
+	while( i && isdigit( name[i-1] ) )
+	{
+		--i;
+	}
+	prefix = name.substr( 0, i );
+	return strtol( name.c_str() + i, nullptr, 10 );
+}
+
+} // namespace
+
+struct GraphComponent::NameIndex : boost::noncopyable
+{
+
+	NameIndex( const ChildContainer &children )
+	{
+		for( const auto &child : children )
+		{
+			add( child.get() );
+		}
+	}
+
+	const GraphComponent *child( const InternedString &name ) const
+	{
+		auto it = m_children.find( name );
+		return it != m_children.end() ? it->second : nullptr;
+	}
+
+	void add( const GraphComponent *child )
+	{
+		// Children may briefly share a name while being added, until
+		// `setName()` makes them unique. Like the linear search, we
+		// favour the existing child in that case.
+		if( m_children.insert( { child->getName(), child } ).second )
+		{
+			std::string prefix;
+			const long suffix = splitNumericSuffix( child->getName(), prefix );
+			m_suffixes[prefix].insert( suffix );
+		}
+	}
+
+	void remove( const GraphComponent *child )
+	{
+		auto it = m_children.find( child->getName() );
+		if( it == m_children.end() || it->second != child )
+		{
+			return;
+		}
+
+		m_children.erase( it );
+
+		std::string prefix;
+		const long suffix = splitNumericSuffix( child->getName(), prefix );
+		auto sIt = m_suffixes.find( prefix );
+		sIt->second.erase( sIt->second.find( suffix ) );
+		if( sIt->second.empty() )
+		{
+			m_suffixes.erase( sIt );
+		}
+	}
+
+	// Returns the largest suffix in use with `prefix`, ignoring
+	// `exclude`, or -1 if there is none.
+	long maxSuffix( const std::string &prefix, const GraphComponent *exclude ) const
+	{
+		auto it = m_suffixes.find( prefix );
+		if( it == m_suffixes.end() )
+		{
+			return -1;
+		}
+
+		long excludedSuffix = -1;
+		if( child( exclude->getName() ) == exclude )
+		{
+			std::string excludePrefix;
+			const long suffix = splitNumericSuffix( exclude->getName(), excludePrefix );
+			if( excludePrefix == prefix )
+			{
+				excludedSuffix = suffix;
+			}
+		}
+
+		for( auto sIt = it->second.rbegin(), eIt = it->second.rend(); sIt != eIt; ++sIt )
+		{
+			if( *sIt == excludedSuffix )
+			{
+				excludedSuffix = -1;
+				continue;
+			}
+			return *sIt;
+		}
+
+		return -1;
+	}
+
+	private :
+
+		std::unordered_map<InternedString, const GraphComponent *, InternedStringHash> m_children;
+		std::unordered_map<std::string, std::multiset<long>> m_suffixes;
+
+};
+
 //////////////////////////////////////////////////////////////////////////
 // GraphComponent
 //////////////////////////////////////////////////////////////////////////
@@ -126,13 +259,23 @@ const IECore::InternedString &GraphComponent::setName( const IECore::InternedStr
 	IECore::InternedString newName = name;
 	if( m_parent )
 	{
+		const NameIndex *nameIndex = m_parent->m_nameIndex.get();
+
 		bool uniqueAlready = true;
-		for( ChildContainer::const_iterator it=m_parent->m_children.begin(), eIt=m_parent->m_children.end(); it != eIt; it++ )
+		if( nameIndex )
+		{
+			const GraphComponent *sibling = nameIndex->child( newName );
+			uniqueAlready = !sibling || sibling == this;
+		}
+		else
 		{
-			if( *it != this && (*it)->m_name == newName )
+			for( ChildContainer::const_iterator it=m_parent->m_children.begin(), eIt=m_parent->m_children.end(); it != eIt; it++ )
 			{
-				uniqueAlready = false;
-				break;
+				if( *it != this && (*it)->m_name == newName )
+				{
+					uniqueAlready = false;
+					break;
+				}
 			}
 		}
 
@@ -143,21 +286,28 @@ const IECore::InternedString &GraphComponent::setName( const IECore::InternedStr
 			std::string prefix;
 			int suffix = StringAlgo::numericSuffix( newName.value(), 1, &prefix );
 
-			// iterate over all the siblings to find the minimum value for the suffix which
-			// will be greater than any existing suffix.
-			for( ChildContainer::const_iterator it=m_parent->m_children.begin(), eIt=m_parent->m_children.end(); it != eIt; it++ )
+			// find the minimum value for the suffix which will be greater than
+			// any existing suffix.
+			if( nameIndex )
 			{
-				if( *it == this )
-				{
-					continue;
-				}
-				if( (*it)->m_name.value().compare( 0, prefix.size(), prefix ) == 0 )
+				suffix = max( suffix, (int)nameIndex->maxSuffix( prefix, this ) + 1 );
+			}
+			else
+			{
+				for( ChildContainer::const_iterator it=m_parent->m_children.begin(), eIt=m_parent->m_children.end(); it != eIt; it++ )
 				{
-					char *endPtr = nullptr;
-					long siblingSuffix = strtol( (*it)->m_name.value().c_str() + prefix.size(), &endPtr, 10 );
-					if( *endPtr == '\0' )
+					if( *it == this )
 					{
-						suffix = max( suffix, (int)siblingSuffix + 1 );
+						continue;
+					}
+					if( (*it)->m_name.value().compare( 0, prefix.size(), prefix ) == 0 )
+					{
+						char *endPtr = nullptr;
+						long siblingSuffix = strtol( (*it)->m_name.value().c_str() + prefix.size(), &endPtr, 10 );
+						if( *endPtr == '\0' )
+						{
+							suffix = max( suffix, (int)siblingSuffix + 1 );
+						}
 					}
 				}
 			}
@@ -184,7 +334,16 @@ const IECore::InternedString &GraphComponent::setName( const IECore::InternedStr
 
 void GraphComponent::setNameInternal( const IECore::InternedString &name )
 {
+	NameIndex *nameIndex = m_parent ? m_parent->m_nameIndex.get() : nullptr;
+	if( nameIndex )
+	{
+		nameIndex->remove( this );
+	}
 	m_name = name;
+	if( nameIndex )
+	{
+		nameIndex->add( this );
+	}
 	Signals::emitLazily( m_signals.get(), &Signals::nameChangedSignal, this );
 }
 
@@ -341,6 +500,14 @@ void GraphComponent::addChildInternal( GraphComponentPtr child, size_t index )
 
 	m_children.insert( m_children.begin() + min( index, m_children.size() ), child );
 	child->m_parent = this;
+	if( m_nameIndex )
+	{
+		m_nameIndex->add( child.get() );
+	}
+	else if( m_children.size() >= g_nameIndexThreshold )
+	{
+		m_nameIndex.reset( new NameIndex( m_children ) );
+	}
 	child->setName( child->m_name.value() ); // to force uniqueness
 	Signals::emitLazily( m_signals.get(), &Signals::childAddedSignal, this, child.get() );
 	child->parentChanged( previousParent );
@@ -403,7 +570,15 @@ void GraphComponent::removeChildInternal( GraphComponentPtr child, bool emitPare
 		// recorded and replayed automatically.
 		throw Exception( boost::str( boost::format( "GraphComponent::removeChildInternal : \"%s\" is not a child of \"%s\"." ) % child->fullName() % fullName() ) );
 	}
+	if( m_nameIndex )
+	{
+		m_nameIndex->remove( child.get() );
+	}
 	m_children.erase( it );
+	if( m_children.empty() )
+	{
+		m_nameIndex.reset();
+	}
 	child->m_parent = nullptr;
 	Signals::emitLazily( m_signals.get(), &Signals::childRemovedSignal, this, child.get() );
 	if( emitParentChanged )
@@ -420,6 +595,23 @@ size_t GraphComponent::index() const
 	return std::find( c.begin(), c.end(), this ) - c.begin();
 }
 
+const GraphComponent *GraphComponent::childInternal( const IECore::InternedString &name ) const
+{
+	if( m_nameIndex )
+	{
+		return m_nameIndex->child( name );
+	}
+
+	for( ChildContainer::const_iterator it=m_children.begin(), eIt=m_children.end(); it!=eIt; it++ )
+	{
+		if( (*it)->m_name==name )
+		{
+			return it->get();
+		}
+	}
+	return nullptr;
+}
+
 const GraphComponent::ChildContainer &GraphComponent::children() const
 {
 	return m_children;
@@ -41,6 +41,19 @@
 
 #include "boost/bind.hpp"
 
+namespace
+{
+
+// Iteration N of a loop depends on iteration N - 1, which depends on N - 2
+// and so on. Evaluating the final iteration directly would therefore recurse
+// through a chain of nested processes as deep as the number of iterations,
+// risking stack exhaustion for large loops. Instead we first evaluate every
+// `g_iterationStride`th iteration in ascending order, so that each evaluation
+// finds its predecessors in the cache and recursion is bounded by the stride.
+const int g_iterationStride = 50;
+
+} // namespace
+
 namespace Gaffer
 {
 
@@ -197,6 +210,14 @@ void Loop::hash( const ValuePlug *output, const Context *context, IECore::Murmur
 		Context::EditableScope tmpContext( context );
 		if( index >= 0 )
 		{
+			if( evaluateIterationsIncrementally( output, index ) )
+			{
+				for( int i = g_iterationStride - 1; i < index; i += g_iterationStride )
+				{
+					tmpContext.set<int>( indexVariable, i );
+					plug->hash();
+				}
+			}
 			tmpContext.set<int>( indexVariable, index );
 		}
 		else
@@ -219,6 +240,16 @@ void Loop::compute( ValuePlug *output, const Context *context ) const
 		Context::EditableScope tmpContext( context );
 		if( index >= 0 )
 		{
+			if( evaluateIterationsIncrementally( output, index ) )
+			{
+				// Each call replaces the value set by the previous one,
+				// and the final call below provides the actual result.
+				for( int i = g_iterationStride - 1; i < index; i += g_iterationStride )
+				{
+					tmpContext.set<int>( indexVariable, i );
+					output->setFrom( plug );
+				}
+			}
 			tmpContext.set<int>( indexVariable, index );
 		}
 		else
@@ -232,6 +263,14 @@ void Loop::compute( ValuePlug *output, const Context *context ) const
 	ComputeNode::compute( output, context );
 }
 
+bool Loop::evaluateIterationsIncrementally( const ValuePlug *output, int index ) const
+{
+	// We only do this for `outPlug()`, because `previousPlug()` is evaluated
+	// at every iteration, and it would be wasteful to revisit all the
+	// preceding iterations each time.
+	return index >= g_iterationStride && ( output == outPlug() || outPlug()->isAncestorOf( output ) );
+}
+
 void Loop::childAdded()
 {
 	setupPlugs();
@@ -39,12 +39,14 @@
 #include "Gaffer/Action.h"
 #include "Gaffer/Node.h"
 #include "Gaffer/Plug.h"
+#include "Gaffer/Private/IECorePreview/LRUCache.h"
 
 #include "IECore/CompoundData.h"
 #include "IECore/SimpleTypedData.h"
 #include "IECore/StringAlgo.h"
 
 #include "boost/bind.hpp"
+#include "boost/functional/hash.hpp"
 #include "boost/multi_index/member.hpp"
 #include "boost/multi_index/ordered_index.hpp"
 #include "boost/multi_index/sequenced_index.hpp"
@@ -123,6 +125,148 @@ GraphComponentMetadataMap &graphComponentMetadataMap()
 	return m;
 }
 
+// Searching `graphComponentMetadataMap()` involves walking the type hierarchy
+// and matching plug paths against wildcard patterns, and otherwise dominates
+// the cost of building UIs for large nodes. So we cache the value function
+// found by each search. We cache the functions rather than the values
+// themselves, because functions may return different values on each call.
+// Plug path searches are made relative to every ancestor of a plug, so the
+// number of distinct searches grows with the size of the script; we bound
+// the caches so that they don't retain entries for the lifetime of the
+// session. They are cleared whenever a type or plug path registration changes.
+
+struct LookupKey
+{
+
+	LookupKey()
+		:	typeId( InvalidTypeId )
+	{
+	}
+
+	LookupKey( IECore::TypeId typeId, const vector<InternedString> &plugPath, InternedString key )
+		:	typeId( typeId ), plugPath( plugPath ), key( key )
+	{
+	}
+
+	bool operator == ( const LookupKey &other ) const
+	{
+		return typeId == other.typeId && key == other.key && plugPath == other.plugPath;
+	}
+
+	IECore::TypeId typeId;
+	vector<InternedString> plugPath;
+	InternedString key;
+
+};
+
+// Required by the LRUCache.
+size_t hash_value( const LookupKey &k )
+{
+	// InternedStrings are unique, so we can hash the addresses.
+	size_t result = 0;
+	boost::hash_combine( result, k.typeId );
+	boost::hash_combine( result, k.key.c_str() );
+	for( const auto &name : k.plugPath )
+	{
+		boost::hash_combine( result, name.c_str() );
+	}
+	return result;
+}
+
+// Returns the function registered for `key` against `typeId` or
+// its closest base type, or null if there is none.
+const Metadata::GraphComponentValueFunction *typeValueFunctionSearch( const LookupKey &lookupKey, size_t &cost )
+{
+	cost = 1;
+	IECore::TypeId typeId = lookupKey.typeId;
+	while( typeId != InvalidTypeId )
+	{
+		auto nIt = graphComponentMetadataMap().find( typeId );
+		if( nIt != graphComponentMetadataMap().end() )
+		{
+			auto vIt = nIt->second.values.find( lookupKey.key );
+			if( vIt != nIt->second.values.end() )
+			{
+				return &vIt->second;
+			}
+		}
+		typeId = RunTimeTyped::baseTypeId( typeId );
+	}
+	return nullptr;
+}
+
+// Returns the function registered for `key` against `plugPath` relative
+// to `typeId` or its closest base type, or null if there is none.
+const Metadata::PlugValueFunction *plugValueFunctionSearch( const LookupKey &lookupKey, size_t &cost )
+{
+	cost = 1;
+	IECore::TypeId typeId = lookupKey.typeId;
+	while( typeId != InvalidTypeId )
+	{
+		auto nIt = graphComponentMetadataMap().find( typeId );
+		if( nIt != graphComponentMetadataMap().end() )
+		{
+			// First do a direct lookup using the plug path.
+			auto it = nIt->second.plugPathsToValues.find( lookupKey.plugPath );
+			const auto eIt = nIt->second.plugPathsToValues.end();
+			if( it != eIt )
+			{
+				auto vIt = it->second.find( lookupKey.key );
+				if( vIt != it->second.end() )
+				{
+					return &vIt->second;
+				}
+			}
+			// And only if the direct lookup fails, do a full search using
+			// wildcard matches.
+			for( it = nIt->second.plugPathsToValues.begin(); it != eIt; ++it )
+			{
+				if( StringAlgo::match( lookupKey.plugPath, it->first ) )
+				{
+					auto vIt = it->second.find( lookupKey.key );
+					if( vIt != it->second.end() )
+					{
+						return &vIt->second;
+					}
+				}
+			}
+		}
+		typeId = RunTimeTyped::baseTypeId( typeId );
+	}
+	return nullptr;
+}
+
+typedef IECorePreview::LRUCache<LookupKey, const Metadata::GraphComponentValueFunction *> TypeValueCache;
+typedef IECorePreview::LRUCache<LookupKey, const Metadata::PlugValueFunction *> PlugValueCache;
+
+TypeValueCache &typeValueCache()
+{
+	static TypeValueCache c( typeValueFunctionSearch, 10000 );
+	return c;
+}
+
+PlugValueCache &plugValueCache()
+{
+	static PlugValueCache c( plugValueFunctionSearch, 10000 );
+	return c;
+}
+
+void clearLookupCaches()
+{
+	typeValueCache().clear();
+	plugValueCache().clear();
+}
+
+const Metadata::GraphComponentValueFunction *typeValueFunction( IECore::TypeId typeId, InternedString key )
+{
+	return typeValueCache().get( LookupKey( typeId, vector<InternedString>(), key ) );
+}
+
+const Metadata::PlugValueFunction *plugValueFunction( IECore::TypeId ancestorTypeId, const vector<InternedString> &plugPath, InternedString key )
+{
+	return plugValueCache().get( LookupKey( ancestorTypeId, plugPath, key ) );
+}
+
 struct NamedInstanceValue
 {
 	NamedInstanceValue( InternedString n, ConstDataPtr v, bool p )
@@ -386,6 +530,8 @@ void Metadata::registerValue( IECore::TypeId typeId, IECore::InternedString key,
 		m.replace( it, namedValue );
 	}
 
+	clearLookupCaches();
+
 	if( typeId == Node::staticTypeId() || RunTimeTyped::inheritsFrom( typeId, Node::staticTypeId() ) )
 	{
 		nodeValueChangedSignal()( typeId, key, nullptr );
@@ -406,6 +552,7 @@ void Metadata::deregisterValue( IECore::TypeId typeId, IECore::InternedString ke
 	}
 
 	m.erase( it );
+	clearLookupCaches();
 
 	if( typeId == Node::staticTypeId() || RunTimeTyped::inheritsFrom( typeId, Node::staticTypeId() ) )
 	{
@@ -429,6 +576,8 @@ void Metadata::deregisterValue( IECore::TypeId ancestorTypeId, const StringAlgo:
 	}
 
 	plugValues.erase( it );
+	clearLookupCaches();
+
 	plugValueChangedSignal()( ancestorTypeId, plugPath, key, nullptr );
 }
 
@@ -495,6 +644,8 @@ void Metadata::registerValue( IECore::TypeId ancestorTypeId, const StringAlgo::M
 		plugValues.replace( it, namedValue );
 	}
 
+	clearLookupCaches();
+
 	plugValueChangedSignal()( ancestorTypeId, plugPath, key, nullptr );
 }
 
@@ -624,38 +775,9 @@ IECore::ConstDataPtr Metadata::valueInternal( const GraphComponent *target, IECo
 		vector<InternedString> plugPath( { plug->getName() } );
 		while( ancestor )
 		{
-			IECore::TypeId typeId = ancestor->typeId();
-			while( typeId != InvalidTypeId )
+			if( const PlugValueFunction *f = plugValueFunction( ancestor->typeId(), plugPath, key ) )
 			{
-				auto nIt = graphComponentMetadataMap().find( typeId );
-				if( nIt != graphComponentMetadataMap().end() )
-				{
-					// First do a direct lookup using the plug path.
-					auto it = nIt->second.plugPathsToValues.find( plugPath );
-					const auto eIt = nIt->second.plugPathsToValues.end();
-					if( it != eIt )
-					{
-						auto vIt = it->second.find( key );
-						if( vIt != it->second.end() )
-						{
-							return vIt->second( plug );
-						}
-					}
-					// And only if the direct lookup fails, do a full search using
-					// wildcard matches.
-					for( it = nIt->second.plugPathsToValues.begin(); it != eIt; ++it )
-					{
-						if( StringAlgo::match( plugPath, it->first ) )
-						{
-							auto vIt = it->second.find( key );
-							if( vIt != it->second.end() )
-							{
-								return vIt->second( plug );
-							}
-						}
-					}
-				}
-				typeId = RunTimeTyped::baseTypeId( typeId );
+				return (*f)( plug );
 			}
 
 			plugPath.insert( plugPath.begin(), ancestor->getName() );
@@ -665,19 +787,9 @@ IECore::ConstDataPtr Metadata::valueInternal( const GraphComponent *target, IECo
 
 	// Finally look for values registered to the type
 
-	IECore::TypeId typeId = target->typeId();
-	while( typeId != InvalidTypeId )
+	if( const GraphComponentValueFunction *f = typeValueFunction( target->typeId(), key ) )
 	{
-		auto nIt = graphComponentMetadataMap().find( typeId );
-		if( nIt != graphComponentMetadataMap().end() )
-		{
-			auto vIt = nIt->second.values.find( key );
-			if( vIt != nIt->second.values.end() )
-			{
-				return vIt->second( target );
-			}
-		}
-		typeId = RunTimeTyped::baseTypeId( typeId );
+		return (*f)( target );
 	}
 
 	return nullptr;
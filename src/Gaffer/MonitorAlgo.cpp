@@ -41,12 +41,16 @@
 #include "Gaffer/Node.h"
 #include "Gaffer/PerformanceMonitor.h"
 #include "Gaffer/Plug.h"
+#include "Gaffer/TraceMonitor.h"
 
 #include "IECore/SimpleTypedData.h"
 
 #include "boost/lexical_cast.hpp"
+#include "boost/unordered_map.hpp"
 
 #include <iomanip>
+#include <map>
+#include <set>
 
 using namespace Imath;
 using namespace IECore;
@@ -538,6 +542,281 @@ ContextMonitor::Statistics annotateContextWalk( Node &node, const ContextMonitor
 
 } // namespace
 
+//////////////////////////////////////////////////////////////////////////
+// Parallelism analysis utilities
+//////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+using Nanoseconds = boost::chrono::nanoseconds;
+using Seconds = boost::chrono::duration<double>;
+
+Nanoseconds eventEnd( const TraceMonitor::Event &event )
+{
+	return event.start + event.duration;
+}
+
+// A period of time during which `event` was the innermost
+// process running on its thread.
+struct Interval
+{
+	Nanoseconds start;
+	Nanoseconds end;
+	size_t event;
+};
+
+std::vector<Interval> innermostIntervals( const TraceMonitor::Events &events )
+{
+	std::map<size_t, std::vector<size_t>> threadEvents;
+	for( size_t i = 0, e = events.size(); i < e; ++i )
+	{
+		threadEvents[events[i].threadIndex].push_back( i );
+	}
+
+	std::vector<Interval> result;
+	for( auto &t : threadEvents )
+	{
+		// Events on a single thread are nested, so we can visit them
+		// in start order using a stack. Where two events start at the
+		// same time, the longer one must be the outer one.
+		std::stable_sort(
+			t.second.begin(), t.second.end(),
+			[&events] ( size_t a, size_t b ) {
+				if( events[a].start != events[b].start )
+				{
+					return events[a].start < events[b].start;
+				}
+				return events[a].duration > events[b].duration;
+			}
+		);
+
+		std::vector<size_t> stack;
+		Nanoseconds time( 0 );
+		auto popUntil = [&] ( Nanoseconds t ) {
+			while( !stack.empty() && eventEnd( events[stack.back()] ) <= t )
+			{
+				const Nanoseconds end = eventEnd( events[stack.back()] );
+				if( end > time )
+				{
+					result.push_back( { time, end, stack.back() } );
+					time = end;
+				}
+				stack.pop_back();
+			}
+		};
+
+		for( size_t i : t.second )
+		{
+			popUntil( events[i].start );
+			if( !stack.empty() && events[i].start > time )
+			{
+				result.push_back( { time, events[i].start, stack.back() } );
+			}
+			time = events[i].start;
+			stack.push_back( i );
+		}
+		popUntil( Nanoseconds::max() );
+	}
+
+	return result;
+}
+
+// The critical path is estimated from the parent/child relationships
+// between events. Children running on the same thread as their parent
+// are assumed to depend on one another, because they were launched in
+// sequence by the parent's compute. Children on other threads were
+// launched as parallel tasks, and are assumed to be independent. Time
+// spent by the parent waiting for its tasks can't be distinguished from
+// real work, so the estimate is conservative for parallel computes.
+struct CriticalPath
+{
+
+	CriticalPath( const TraceMonitor::Events &events )
+		:	m_events( events ), m_children( events.size() ), m_spans( events.size(), Nanoseconds( 0 ) )
+	{
+		std::vector<size_t> roots;
+		for( size_t i = 0, e = events.size(); i < e; ++i )
+		{
+			if( events[i].parent == TraceMonitor::Event::noParent )
+			{
+				roots.push_back( i );
+			}
+			else
+			{
+				m_children[events[i].parent].push_back( i );
+			}
+		}
+
+		// Compute spans in post-order. We avoid recursion
+		// because process stacks can be very deep.
+		std::vector<std::pair<size_t, bool>> stack;
+		for( size_t root : roots )
+		{
+			stack.push_back( { root, false } );
+			while( !stack.empty() )
+			{
+				auto &top = stack.back();
+				if( !top.second )
+				{
+					top.second = true;
+					const size_t event = top.first;
+					for( size_t child : m_children[event] )
+					{
+						stack.push_back( { child, false } );
+					}
+					continue;
+				}
+				m_spans[top.first] = span( top.first );
+				stack.pop_back();
+			}
+		}
+
+		m_root = TraceMonitor::Event::noParent;
+		for( size_t root : roots )
+		{
+			if( m_root == TraceMonitor::Event::noParent || m_spans[root] > m_spans[m_root] )
+			{
+				m_root = root;
+			}
+		}
+	}
+
+	Nanoseconds duration() const
+	{
+		return m_root != TraceMonitor::Event::noParent ? m_spans[m_root] : Nanoseconds( 0 );
+	}
+
+	// Calls `f( eventIndex, duration )` for each portion of the
+	// critical path.
+	template<typename F>
+	void visit( F &&f ) const
+	{
+		std::vector<size_t> stack;
+		if( m_root != TraceMonitor::Event::noParent )
+		{
+			stack.push_back( m_root );
+		}
+
+		while( !stack.empty() )
+		{
+			const size_t event = stack.back();
+			stack.pop_back();
+
+			const Children c = children( event );
+			f( event, c.self );
+			if( c.serialSpan >= c.parallelSpan )
+			{
+				stack.insert( stack.end(), c.serial.begin(), c.serial.end() );
+			}
+			else
+			{
+				stack.push_back( c.longestParallel );
+			}
+		}
+	}
+
+	private :
+
+		struct Children
+		{
+			Nanoseconds self;
+			std::vector<size_t> serial;
+			Nanoseconds serialSpan;
+			Nanoseconds parallelSpan;
+			size_t longestParallel;
+		};
+
+		Children children( size_t event ) const
+		{
+			const TraceMonitor::Event &e = m_events[event];
+			Children result = { e.duration, {}, Nanoseconds( 0 ), Nanoseconds( 0 ), TraceMonitor::Event::noParent };
+			for( size_t child : m_children[event] )
+			{
+				if( m_events[child].threadIndex == e.threadIndex )
+				{
+					result.self -= m_events[child].duration;
+					result.serial.push_back( child );
+					result.serialSpan += m_spans[child];
+				}
+				else if( m_spans[child] > result.parallelSpan )
+				{
+					result.parallelSpan = m_spans[child];
+					result.longestParallel = child;
+				}
+			}
+			result.self = std::max( result.self, Nanoseconds( 0 ) );
+			return result;
+		}
+
+		Nanoseconds span( size_t event ) const
+		{
+			const Children c = children( event );
+			return c.self + std::max( c.serialSpan, c.parallelSpan );
+		}
+
+		const TraceMonitor::Events &m_events;
+		std::vector<std::vector<size_t>> m_children;
+		std::vector<Nanoseconds> m_spans;
+		size_t m_root;
+
+};
+
+const GraphComponent *eventOwner( const TraceMonitor::Event &event )
+{
+	if( const Node *node = event.plug->node() )
+	{
+		return node;
+	}
+	return event.plug;
+}
+
+typedef boost::unordered_map<const GraphComponent *, Nanoseconds> DurationMap;
+
+std::string formatDurations( const DurationMap &durations, const std::string &description, size_t maxLines )
+{
+	typedef std::pair<const GraphComponent *, Nanoseconds> Item;
+	std::vector<Item> v( durations.begin(), durations.end() );
+	std::sort(
+		v.begin(), v.end(),
+		[] ( const Item &a, const Item &b ) {
+			return a.second > b.second;
+		}
+	);
+
+	std::vector<std::string> names;
+	std::vector<Seconds> values;
+	for( size_t i = 0; i < maxLines && i < v.size(); ++i )
+	{
+		if( v[i].second == Nanoseconds( 0 ) )
+		{
+			break;
+		}
+		names.push_back( v[i].first->relativeName( v[i].first->ancestor( (IECore::TypeId)ScriptNodeTypeId ) ) );
+		values.push_back( v[i].second );
+	}
+
+	if( names.empty() )
+	{
+		return "";
+	}
+
+	std::stringstream s;
+	s << "Top " << names.size() << " nodes by " << description << " :\n\n";
+	outputItems( names, values, s );
+	return s.str();
+}
+
+template<typename T>
+std::string formatValue( const T &value )
+{
+	std::stringstream s;
+	s << std::fixed << ": " << value;
+	return s.str();
+}
+
+} // namespace
+
 //////////////////////////////////////////////////////////////////////////
 // Implementation of public functions
 //////////////////////////////////////////////////////////////////////////
@@ -586,6 +865,121 @@ std::string formatStatistics( const PerformanceMonitor &monitor, PerformanceMetr
 	return dispatchMetric<FormatStatistics>( FormatStatistics( monitor.allStatistics(), maxLines ), metric );
 }
 
+std::string formatStatistics( const TraceMonitor &monitor, size_t maxLinesPerMetric )
+{
+	const TraceMonitor::Events events = monitor.events();
+	const std::vector<Interval> intervals = innermostIntervals( events );
+
+	// Sweep through the intervals, tracking how many threads were busy
+	// at each moment. Time when only a single thread was busy is
+	// attributed to the node being computed by that thread.
+
+	typedef std::pair<Nanoseconds, int> Boundary;
+	std::vector<Boundary> boundaries;
+	boundaries.reserve( intervals.size() * 2 );
+	Nanoseconds busy( 0 );
+	for( size_t i = 0, e = intervals.size(); i < e; ++i )
+	{
+		// Ends are encoded as negative values so that they sort
+		// before starts at the same time.
+		boundaries.push_back( Boundary( intervals[i].start, (int)i + 1 ) );
+		boundaries.push_back( Boundary( intervals[i].end, -(int)i - 1 ) );
+		busy += intervals[i].end - intervals[i].start;
+	}
+	std::sort( boundaries.begin(), boundaries.end() );
+
+	std::vector<Nanoseconds> concurrency;
+	DurationMap serialDurations;
+	std::set<int> active;
+	for( size_t i = 0, e = boundaries.size(); i < e; ++i )
+	{
+		if( boundaries[i].second > 0 )
+		{
+			active.insert( boundaries[i].second - 1 );
+		}
+		else
+		{
+			active.erase( -boundaries[i].second - 1 );
+		}
+
+		if( i + 1 == e )
+		{
+			break;
+		}
+
+		const Nanoseconds d = boundaries[i+1].first - boundaries[i].first;
+		if( concurrency.size() <= active.size() )
+		{
+			concurrency.resize( active.size() + 1, Nanoseconds( 0 ) );
+		}
+		concurrency[active.size()] += d;
+		if( active.size() == 1 )
+		{
+			serialDurations[eventOwner( events[intervals[*active.begin()].event] )] += d;
+		}
+	}
+
+	const CriticalPath criticalPath( events );
+	DurationMap criticalPathDurations;
+	criticalPath.visit(
+		[&] ( size_t event, Nanoseconds d ) {
+			criticalPathDurations[eventOwner( events[event] )] += d;
+		}
+	);
+
+	// Output summary
+
+	const Nanoseconds wall = boundaries.size() ? boundaries.back().first - boundaries.front().first : Nanoseconds( 0 );
+	const Nanoseconds serial = concurrency.size() > 1 ? concurrency[1] : Nanoseconds( 0 );
+
+	std::vector<std::string> names = {
+		"Wall time",
+		"Busy time",
+		"Serial time",
+		"Average parallelism",
+		"Critical path",
+		"Maximum speedup",
+		"Discarded events"
+	};
+
+	std::vector<std::string> values = {
+		formatValue( Seconds( wall ) ),
+		formatValue( Seconds( busy ) ),
+		formatValue( Seconds( serial ) ),
+		formatValue( wall.count() ? (double)busy.count() / wall.count() : 0.0 ),
+		formatValue( Seconds( criticalPath.duration() ) ),
+		formatValue( criticalPath.duration().count() ? (double)busy.count() / criticalPath.duration().count() : 0.0 ),
+		formatValue( monitor.numDiscardedEvents() )
+	};
+
+	std::stringstream ss;
+	ss << "TraceMonitor Summary :\n\n";
+	outputItems( names, values, ss );
+
+	names.clear();
+	values.clear();
+	for( size_t i = 0; i < concurrency.size(); ++i )
+	{
+		names.push_back( std::to_string( i ) );
+		values.push_back( formatValue( Seconds( concurrency[i] ) ) );
+	}
+
+	ss << "\nTime with N threads busy :\n\n";
+	outputItems( names, values, ss );
+
+	std::string s = ss.str();
+	for( const auto &d : { std::make_pair( &serialDurations, "serial time" ), std::make_pair( &criticalPathDurations, "critical path time" ) } )
+	{
+		const std::string f = formatDurations( *d.first, d.second, maxLinesPerMetric );
+		if( f.size() )
+		{
+			s += "\n" + f;
+		}
+	}
+
+	return s;
+}
+
 void annotate( Node &root, const PerformanceMonitor &monitor )
 {
 	for( int m = First; m <= Last; ++m )
@@ -0,0 +1,290 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2019, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//      * Redistributions of source code must retain the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer.
+//
+//      * Redistributions in binary form must reproduce the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer in the documentation and/or other materials provided with
+//        the distribution.
+//
+//      * Neither the name of John Haddon nor the names of
+//        any other contributors to this software may be used to endorse or
+//        promote products derived from this software without specific prior
+//        written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+#include "Gaffer/TraceMonitor.h"
+
+#include "Gaffer/Context.h"
+#include "Gaffer/Node.h"
+#include "Gaffer/Plug.h"
+#include "Gaffer/Process.h"
+
+#include "IECore/Exception.h"
+
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+
+using namespace Gaffer;
+
+namespace
+{
+
+std::atomic<size_t> g_threadIndex( 0 );
+
+void writeEscaped( std::ostream &stream, const char *s )
+{
+	for( ; *s; ++s )
+	{
+		switch( *s )
+		{
+			case '"' :
+				stream << "\\\"";
+				break;
+			case '\\' :
+				stream << "\\\\";
+				break;
+			default :
+				if( (unsigned char)*s < 0x20 )
+				{
+					stream << "\\u" << std::hex << std::setw( 4 ) << std::setfill( '0' ) << (int)*s << std::dec;
+				}
+				else
+				{
+					stream << *s;
+				}
+		}
+	}
+}
+
+} // namespace
+
+//////////////////////////////////////////////////////////////////////////
+// TraceMonitor::Event
+//////////////////////////////////////////////////////////////////////////
+
+const size_t TraceMonitor::Event::noParent = std::numeric_limits<size_t>::max();
+
+//////////////////////////////////////////////////////////////////////////
+// TraceMonitor::ThreadData
+//////////////////////////////////////////////////////////////////////////
+
+TraceMonitor::ThreadData::ThreadData()
+	:	next( 0 ), numDiscarded( 0 ), threadIndex( g_threadIndex++ )
+{
+}
+
+//////////////////////////////////////////////////////////////////////////
+// TraceMonitor
+//////////////////////////////////////////////////////////////////////////
+
+TraceMonitor::TraceMonitor( size_t maxEventsPerThread )
+	:	m_maxEventsPerThread( std::max<size_t>( maxEventsPerThread, 1 ) ), m_origin( Clock::now() )
+{
+}
+
+TraceMonitor::~TraceMonitor()
+{
+}
+
+TraceMonitor::Events TraceMonitor::events() const
+{
+	std::vector<Record> records;
+	for( const auto &threadData : m_threadData )
+	{
+		records.insert( records.end(), threadData.records.begin(), threadData.records.end() );
+	}
+
+	std::sort(
+		records.begin(), records.end(),
+		[] ( const Record &a, const Record &b ) {
+			return a.event.start < b.event.start;
+		}
+	);
+
+	// Resolve parents. Process addresses may be reused once a
+	// process has finished, so for each process we keep all the
+	// records using its address, and choose the one whose lifetime
+	// contains the child.
+
+	boost::unordered_map<const Process *, std::vector<size_t>> processRecords;
+	for( size_t i = 0, e = records.size(); i < e; ++i )
+	{
+		processRecords[records[i].process].push_back( i );
+	}
+
+	Events result;
+	result.reserve( records.size() );
+	for( const auto &record : records )
+	{
+		result.push_back( record.event );
+		Event &event = result.back();
+		event.parent = Event::noParent;
+		if( !record.parentProcess )
+		{
+			continue;
+		}
+
+		auto it = processRecords.find( record.parentProcess );
+		if( it == processRecords.end() )
+		{
+			// Parent event was discarded, or started before
+			// the monitor was made active.
+			continue;
+		}
+
+		// Indices are ordered by start time, so we want the
+		// last candidate which started before the child.
+		const std::vector<size_t> &candidates = it->second;
+		auto cIt = std::upper_bound(
+			candidates.begin(), candidates.end(), event.start,
+			[&records] ( boost::chrono::nanoseconds start, size_t index ) {
+				return start < records[index].event.start;
+			}
+		);
+		if( cIt == candidates.begin() )
+		{
+			continue;
+		}
+		const Event &candidate = records[*(cIt - 1)].event;
+		if( candidate.start + candidate.duration >= event.start + event.duration )
+		{
+			event.parent = *(cIt - 1);
+		}
+	}
+
+	return result;
+}
+
+size_t TraceMonitor::numDiscardedEvents() const
+{
+	size_t result = 0;
+	for( const auto &threadData : m_threadData )
+	{
+		result += threadData.numDiscarded;
+	}
+	return result;
+}
+
+void TraceMonitor::writeTrace( std::ostream &stream ) const
+{
+	// We output "complete" events (phase "X") rather than pairs
+	// of begin and end events, because they are more compact and
+	// can't be mismatched by the discarding of old events.
+	// Timestamps are specified in microseconds.
+
+	stream << "{\n\"traceEvents\" : [\n";
+
+	const Events e = events();
+	for( Events::const_iterator it = e.begin(), eIt = e.end(); it != eIt; ++it )
+	{
+		const Node *node = it->plug->node();
+
+		stream << "{ \"name\" : \"";
+		writeEscaped( stream, it->plug->fullName().c_str() );
+		stream << "\", \"cat\" : \"";
+		writeEscaped( stream, it->type.c_str() );
+		stream << "\", \"ph\" : \"X\", \"pid\" : 0, \"tid\" : " << it->threadIndex;
+		stream << ", \"ts\" : " << std::fixed << std::setprecision( 3 ) << it->start.count() / 1000.0;
+		stream << ", \"dur\" : " << it->duration.count() / 1000.0;
+		stream << ", \"args\" : { \"nodeType\" : \"";
+		writeEscaped( stream, node ? node->typeName() : "" );
+		stream << "\", \"contextHash\" : \"" << it->contextHash.toString() << "\" } }";
+		if( it + 1 != eIt )
+		{
+			stream << ",";
+		}
+		stream << "\n";
+	}
+
+	stream << "],\n\"displayTimeUnit\" : \"ms\",\n";
+	stream << "\"otherData\" : { \"discardedEvents\" : " << numDiscardedEvents() << " }\n}\n";
+}
+
+void TraceMonitor::writeTrace( const std::string &fileName ) const
+{
+	std::ofstream stream( fileName.c_str() );
+	if( !stream.good() )
+	{
+		throw IECore::IOException( "Unable to open file \"" + fileName + "\"" );
+	}
+	writeTrace( stream );
+}
+
+void TraceMonitor::processStarted( const Process *process )
+{
+	ThreadData &threadData = m_threadData.local();
+	threadData.startStack.push_back( Clock::now() );
+}
+
+void TraceMonitor::processFinished( const Process *process )
+{
+	const Clock::time_point now = Clock::now();
+	ThreadData &threadData = m_threadData.local();
+	if( threadData.startStack.empty() )
+	{
+		// Process was started before we were made active.
+		return;
+	}
+
+	Event event;
+	event.plug = process->plug();
+	event.type = process->type();
+	event.contextHash = process->context()->hash();
+	event.threadIndex = threadData.threadIndex;
+	event.start = threadData.startStack.back() - m_origin;
+	event.duration = now - threadData.startStack.back();
+	event.parent = Event::noParent;
+	threadData.startStack.pop_back();
+
+	auto inserted = threadData.plugs.insert( { event.plug, { nullptr, 0 } } );
+	if( inserted.second )
+	{
+		inserted.first->second.plug = event.plug;
+	}
+	inserted.first->second.numRecords++;
+
+	const Record record = { event, process, process->parent() };
+	if( threadData.records.size() < m_maxEventsPerThread )
+	{
+		threadData.records.push_back( record );
+	}
+	else
+	{
+		// Release the plug for the record we're discarding, if no
+		// other records refer to it, so that memory usage remains
+		// bounded.
+		auto it = threadData.plugs.find( threadData.records[threadData.next].event.plug );
+		if( --it->second.numRecords == 0 )
+		{
+			threadData.plugs.erase( it );
+		}
+		threadData.records[threadData.next] = record;
+		threadData.numDiscarded++;
+	}
+	threadData.next = ( threadData.next + 1 ) % m_maxEventsPerThread;
+}
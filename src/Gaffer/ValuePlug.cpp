@@ -46,7 +46,9 @@
 
 #include "boost/bind.hpp"
 #include "boost/format.hpp"
+#include "boost/noncopyable.hpp"
 
+#include "tbb/concurrent_hash_map.h"
 #include "tbb/enumerable_thread_specific.h"
 
 using namespace Gaffer;
@@ -81,6 +83,161 @@ const IECore::MurmurHash g_nullHash;
 
 } // namespace
 
+//////////////////////////////////////////////////////////////////////////
+// Cache statistics. These are accumulated in thread local storage
+// to avoid contention, and only when explicitly enabled.
+//////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+tbb::atomic<bool> g_cacheStatisticsEnabled;
+
+struct CacheStatisticsThreadData
+{
+	CacheStatisticsThreadData() : lastProcessKey( nullptr ) {}
+	ValuePlug::CacheStatisticsMap statistics;
+	// The key used to launch the most recent process on this thread.
+	// Used by CacheLookup to determine if a lookup was a miss.
+	const void *lastProcessKey;
+};
+
+typedef tbb::enumerable_thread_specific<CacheStatisticsThreadData, tbb::cache_aligned_allocator<CacheStatisticsThreadData>, tbb::ets_key_per_instance> CacheStatisticsStorage;
+CacheStatisticsStorage g_cacheStatisticsStorage;
+
+ValuePlug::CacheStatisticsKey cacheStatisticsKey( const ValuePlug *plug )
+{
+	const Node *node = plug->node();
+	return ValuePlug::CacheStatisticsKey( node ? node->typeId() : IECore::InvalidTypeId, plug->typeId() );
+}
+
+// Must be called by processes on launch, with the key that was used
+// to look them up in the cache.
+inline void processLaunched( const void *key )
+{
+	if( g_cacheStatisticsEnabled )
+	{
+		g_cacheStatisticsStorage.local().lastProcessKey = key;
+	}
+}
+
+// Records statistics for a single cache lookup, made for the
+// lifetime of the CacheLookup. A lookup is deemed to be a miss if
+// `processLaunched( key )` was called on this thread during the
+// lookup. Since nested processes complete before their parents
+// launch, any nested lookups don't affect the result.
+class CacheLookup : boost::noncopyable
+{
+
+	public :
+
+		enum Type
+		{
+			Hash,
+			Compute
+		};
+
+		CacheLookup( Type type, const void *key, const ValuePlug *plug )
+			:	m_threadData( g_cacheStatisticsEnabled ? &g_cacheStatisticsStorage.local() : nullptr ),
+				m_type( type ), m_key( key ), m_plug( plug )
+		{
+			if( m_threadData )
+			{
+				m_threadData->lastProcessKey = nullptr;
+				if( m_type == Compute )
+				{
+					m_start = boost::chrono::high_resolution_clock::now();
+				}
+			}
+		}
+
+		~CacheLookup()
+		{
+			if( !m_threadData )
+			{
+				return;
+			}
+
+			ValuePlug::CacheStatistics &s = m_threadData->statistics[cacheStatisticsKey( m_plug )];
+			const bool miss = m_threadData->lastProcessKey == m_key;
+			if( m_type == Hash )
+			{
+				( miss ? s.hashMisses : s.hashHits )++;
+			}
+			else if( miss )
+			{
+				s.computeMisses++;
+			}
+			else
+			{
+				s.computeHits++;
+				s.computeWaitDuration += boost::chrono::high_resolution_clock::now() - m_start;
+			}
+		}
+
+	private :
+
+		CacheStatisticsThreadData *m_threadData;
+		const Type m_type;
+		const void *m_key;
+		const ValuePlug *m_plug;
+		boost::chrono::high_resolution_clock::time_point m_start;
+
+};
+
+// Records the statistics key and memory usage for each item added to
+// the compute cache, so that we can account for them when they are
+// evicted. Only populated while statistics are enabled.
+struct CacheEntryInfo
+{
+	ValuePlug::CacheStatisticsKey key;
+	size_t memoryUsage;
+};
+
+typedef tbb::concurrent_hash_map<IECore::MurmurHash, CacheEntryInfo> CacheEntryInfoMap;
+CacheEntryInfoMap g_cacheEntryInfo;
+
+void cacheEntryAdded( const IECore::MurmurHash &hash, const ValuePlug *plug, size_t memoryUsage )
+{
+	if( !g_cacheStatisticsEnabled )
+	{
+		return;
+	}
+
+	const ValuePlug::CacheStatisticsKey key = cacheStatisticsKey( plug );
+	CacheEntryInfoMap::accessor a;
+	if( g_cacheEntryInfo.insert( a, hash ) )
+	{
+		a->second = { key, memoryUsage };
+		g_cacheStatisticsStorage.local().statistics[key].computeMemoryUsage += memoryUsage;
+	}
+}
+
+void cacheEntryRemoved( const IECore::MurmurHash &hash, const IECore::ConstObjectPtr &value )
+{
+	if( g_cacheEntryInfo.empty() )
+	{
+		return;
+	}
+
+	CacheEntryInfoMap::accessor a;
+	if( !g_cacheEntryInfo.find( a, hash ) )
+	{
+		return;
+	}
+
+	// Note that `computeMemoryUsage` may wrap around for an individual
+	// thread, because entries are often evicted on a different thread
+	// to the one that added them. The sum over all threads is correct
+	// though.
+	ValuePlug::CacheStatistics &s = g_cacheStatisticsStorage.local().statistics[a->second.key];
+	s.computeEvictions++;
+	s.computeMemoryUsage -= a->second.memoryUsage;
+	g_cacheEntryInfo.erase( a );
+}
+
+} // namespace
+
 //////////////////////////////////////////////////////////////////////////
 // The HashProcess manages the task of calling ComputeNode::hash() and
 // managing a cache of recently computed hashes.
@@ -198,6 +355,8 @@ class ValuePlug::HashProcess : public Process
 			const ComputeNode *computeNode = IECore::runTimeCast<const ComputeNode>( p->node() );
 			const HashProcessKey processKey( p, plug, Context::current(), computeNode, computeNode ? computeNode->hashCachePolicy( p ) : CachePolicy::Uncached );
 
+			CacheLookup lookup( CacheLookup::Hash, &processKey, p );
+
 			if( processKey.cachePolicy == CachePolicy::Uncached )
 			{
 				HashProcess process( processKey );
@@ -278,6 +437,8 @@ class ValuePlug::HashProcess : public Process
 				{
 					throw IECore::Exception( boost::str( boost::format( "ComputeNode::hash() not implemented for Plug \"%s\"." ) % plug()->fullName() ) );
 				}
+
+				processLaunched( &key );
 			}
 			catch( ... )
 			{
@@ -460,6 +621,7 @@ class ValuePlug::ComputeProcess : public Process
 
 			const ComputeNode *computeNode = IECore::runTimeCast<const ComputeNode>( p->node() );
 			const ComputeProcessKey processKey( p, plug, computeNode, computeNode ? computeNode->computeCachePolicy( p ) : CachePolicy::Uncached, precomputedHash );
+			CacheLookup lookup( CacheLookup::Compute, &processKey, p );
 
 			if( processKey.cachePolicy == CachePolicy::Uncached )
 			{
@@ -494,7 +656,11 @@ class ValuePlug::ComputeProcess : public Process
 					/// overhead, and at some point we'll need to address that.
 					if( !g_cache.get( processKey ) )
 					{
-						g_cache.set( processKey, process.m_result, process.m_result->memoryUsage() );
+						const size_t memoryUsage = process.m_result->memoryUsage();
+						if( g_cache.set( processKey, process.m_result, memoryUsage ) )
+						{
+							cacheEntryAdded( processKey, processKey.plug, memoryUsage );
+						}
 					}
 					return process.m_result;
 				}
@@ -550,6 +716,8 @@ class ValuePlug::ComputeProcess : public Process
 				{
 					throw IECore::Exception( boost::str( boost::format( "Value for Plug \"%s\" not set as expected." ) % key.plug->fullName() ) );
 				}
+
+				processLaunched( &key );
 			}
 			catch( ... )
 			{
@@ -589,9 +757,18 @@ class ValuePlug::ComputeProcess : public Process
 					break;
 			}
 			cost = result ? result->memoryUsage() : 0;
+			if( result )
+			{
+				cacheEntryAdded( key, key.plug, cost );
+			}
 			return result;
 		}
 
+		static void cacheRemovalCallback( const IECore::MurmurHash &hash, const IECore::ConstObjectPtr &value )
+		{
+			cacheEntryRemoved( hash, value );
+		}
+
 		// A cache mapping from ValuePlug::hash() to the result of the previous computation
 		// for that hash. This allows us to cache results for faster repeat evaluation
 		typedef IECorePreview::LRUCache<IECore::MurmurHash, IECore::ConstObjectPtr, IECorePreview::LRUCachePolicy::TaskParallel, ComputeProcessKey> Cache;
@@ -602,7 +779,7 @@ class ValuePlug::ComputeProcess : public Process
 };
 
 const IECore::InternedString ValuePlug::ComputeProcess::staticType( "computeNode:compute" );
-ValuePlug::ComputeProcess::Cache ValuePlug::ComputeProcess::g_cache( cacheGetter, 1024 * 1024 * 1024 * 1 ); // 1 gig
+ValuePlug::ComputeProcess::Cache ValuePlug::ComputeProcess::g_cache( cacheGetter, cacheRemovalCallback, 1024 * 1024 * 1024 * 1 ); // 1 gig
 
 //////////////////////////////////////////////////////////////////////////
 // SetValueAction implementation
@@ -991,3 +1168,57 @@ void ValuePlug::setHashCacheSizeLimit( size_t maxEntriesPerThread )
 {
 	HashProcess::setCacheSizeLimit( maxEntriesPerThread );
 }
+
+//////////////////////////////////////////////////////////////////////////
+// Cache statistics
+//////////////////////////////////////////////////////////////////////////
+
+ValuePlug::CacheStatistics::CacheStatistics()
+	:	computeHits( 0 ), computeMisses( 0 ), computeEvictions( 0 ), computeMemoryUsage( 0 ),
+		computeWaitDuration( 0 ), hashHits( 0 ), hashMisses( 0 )
+{
+}
+
+ValuePlug::CacheStatistics &ValuePlug::CacheStatistics::operator += ( const CacheStatistics &rhs )
+{
+	computeHits += rhs.computeHits;
+	computeMisses += rhs.computeMisses;
+	computeEvictions += rhs.computeEvictions;
+	computeMemoryUsage += rhs.computeMemoryUsage;
+	computeWaitDuration += rhs.computeWaitDuration;
+	hashHits += rhs.hashHits;
+	hashMisses += rhs.hashMisses;
+	return *this;
+}
+
+void ValuePlug::setCacheStatisticsEnabled( bool enabled )
+{
+	g_cacheStatisticsEnabled = enabled;
+}
+
+bool ValuePlug::getCacheStatisticsEnabled()
+{
+	return g_cacheStatisticsEnabled;
+}
+
+ValuePlug::CacheStatisticsMap ValuePlug::cacheStatistics()
+{
+	CacheStatisticsMap result;
+	for( const auto &threadData : g_cacheStatisticsStorage )
+	{
+		for( const auto &s : threadData.statistics )
+		{
+			result[s.first] += s.second;
+		}
+	}
+	return result;
+}
+
+void ValuePlug::resetCacheStatistics()
+{
+	for( auto &threadData : g_cacheStatisticsStorage )
+	{
+		threadData.statistics.clear();
+	}
+	g_cacheEntryInfo.clear();
+}
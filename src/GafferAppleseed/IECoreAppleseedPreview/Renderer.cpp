@@ -37,6 +37,7 @@
 #include "GafferScene/Private/IECoreScenePreview/Renderer.h"
 
 #include "GafferScene/Private/IECoreScenePreview/Procedural.h"
+#include "GafferScene/Private/IECoreScenePreview/ShaderCache.h"
 
 #include "IECoreAppleseed/CameraAlgo.h"
 #include "IECoreAppleseed/ColorAlgo.h"
@@ -667,39 +668,23 @@ class ShaderCache : public RefCounted
 		// Can be called concurrently with other get() calls.
 		AppleseedShaderPtr get( const ShaderNetwork *shader )
 		{
-			Cache::accessor a;
-			m_cache.insert( a, shader->Object::hash() );
-			if( !a->second )
-			{
-				a->second = new AppleseedShader( m_project, shader->Object::hash().toString() + "_shadergroup", shader, m_isInteractive );
-			}
-			return a->second;
+			return m_cache.get(
+				shader,
+				[this]( const ShaderNetwork *shader, const MurmurHash &hash ) {
+					return new AppleseedShader( m_project, hash.toString() + "_shadergroup", shader, m_isInteractive );
+				}
+			);
 		}
 
 		// Must not be called concurrently with anything.
 		void clearUnused()
 		{
-			vector<MurmurHash> toErase;
-			for( Cache::iterator it = m_cache.begin(), eIt = m_cache.end(); it != eIt; ++it )
-			{
-				if( it->second->refCount() == 1 )
-				{
-					// Only one reference - this is ours, so
-					// nothing outside of the cache is using the
-					// shader.
-					toErase.push_back( it->first );
-				}
-			}
-			for( vector<MurmurHash>::const_iterator it = toErase.begin(), eIt = toErase.end(); it != eIt; ++it )
-			{
-				m_cache.erase( *it );
-			}
+			m_cache.clearUnused();
 		}
 
 	private :
 
-		typedef tbb::concurrent_hash_map<MurmurHash, AppleseedShaderPtr> Cache;
-		Cache m_cache;
+		IECoreScenePreview::ShaderCache<AppleseedShader> m_cache;
 		asr::Project &m_project;
 		bool m_isInteractive;
 };
@@ -1384,16 +1369,49 @@ class AppleseedPrimitive : public AppleseedEntity
 			return ".binarymesh";
 		}
 
+		// Writes a geom file for the object, unless one already exists.
+		// Because files are named by object hash, this allows identical
+		// geometry to be shared within a render, and between all the
+		// renders which share a project directory.
 		void writeGeomFile( const Object *object, const boost::filesystem::path &path ) const
 		{
-			asf::auto_release_ptr<asr::Object> obj( ObjectAlgo::convert( object ) );
+			// Holding the accessor locks this file only, so other threads
+			// are free to write other files in parallel.
+			GeomFileLocks::accessor a;
+			g_geomFileLocks.insert( a, path.string() );
 
-			// Write the mesh to a binarymesh file.
-			const asr::MeshObject *meshObj = static_cast<const asr::MeshObject *>( obj.get() );
-			if( !asr::MeshObjectWriter::write( *meshObj, "mesh", path.string().c_str() ) )
+			if( !boost::filesystem::exists( path ) )
 			{
-				msg( Msg::Warning, "AppleseedRenderer::object", "Couldn't save mesh primitive." );
+				asf::auto_release_ptr<asr::Object> obj( ObjectAlgo::convert( object ) );
+
+				// Write the mesh to a temporary file and then rename it, so that
+				// other processes never see a partially written file. Appleseed
+				// uses the extension to determine the file format, so we must
+				// preserve it.
+				const boost::filesystem::path tmpPath = path.parent_path() / boost::filesystem::unique_path(
+					path.stem().string() + ".%%%%-%%%%-%%%%" + path.extension().string()
+				);
+
+				const asr::MeshObject *meshObj = static_cast<const asr::MeshObject *>( obj.get() );
+				boost::system::error_code ec;
+				if( !asr::MeshObjectWriter::write( *meshObj, "mesh", tmpPath.string().c_str() ) )
+				{
+					msg( Msg::Warning, "AppleseedRenderer::object", "Couldn't save mesh primitive." );
+					boost::filesystem::remove( tmpPath, ec );
+				}
+				else
+				{
+					boost::filesystem::rename( tmpPath, path, ec );
+					if( ec )
+					{
+						msg( Msg::Warning, "AppleseedRenderer::object", boost::format( "Couldn't rename \"%s\" (%s)." ) % tmpPath.string() % ec.message() );
+						boost::filesystem::remove( tmpPath, ec );
+					}
+				}
 			}
+
+			// The file now exists, so the lock is no longer needed.
+			g_geomFileLocks.erase( a );
 		}
 
 		template<class ObjectType>
@@ -1412,16 +1430,7 @@ class AppleseedPrimitive : public AppleseedEntity
 				string fileName = string( "_geometry/" ) + hash.toString() + filenameExtensionForObject( &object );
 				boost::filesystem::path p = projectPath / fileName;
 
-				// todo: can we do something better than locking here?
-				{
-					boost::lock_guard<boost::mutex> lock( g_geomFilesMutex );
-
-					// Write a geom file for the object if needed.
-					if( !boost::filesystem::exists( p ) )
-					{
-						writeGeomFile( &object, p );
-					}
-				}
+				writeGeomFile( &object, p );
 
 				// Store the filename into the object params.
 				if( samples.size() > 1 )
@@ -1462,8 +1471,10 @@ class AppleseedPrimitive : public AppleseedEntity
 			AppleseedPrimitive::attributes( attributes );
 		}
 
-		// Used to protect mesh file writting for scene description renders.
-		static boost::mutex g_geomFilesMutex;
+		// Used to prevent several threads writing the same geom
+		// file at once, keyed by file path.
+		typedef tbb::concurrent_hash_map<string, bool> GeomFileLocks;
+		static GeomFileLocks g_geomFileLocks;
 
 		asr::TransformSequence m_transformSequence;
 
@@ -1479,7 +1490,7 @@ class AppleseedPrimitive : public AppleseedEntity
 
 };
 
-boost::mutex AppleseedPrimitive::g_geomFilesMutex;
+AppleseedPrimitive::GeomFileLocks AppleseedPrimitive::g_geomFileLocks;
 
 } // namespace
 
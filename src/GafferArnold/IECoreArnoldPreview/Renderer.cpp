@@ -38,7 +38,9 @@
 
 #include "GafferArnold/Private/IECoreArnoldPreview/ShaderNetworkAlgo.h"
 
+#include "Gaffer/Private/IECorePreview/LRUCache.h"
 #include "GafferScene/Private/IECoreScenePreview/Procedural.h"
+#include "GafferScene/Private/IECoreScenePreview/ShaderCache.h"
 
 #include "IECoreArnold/CameraAlgo.h"
 #include "IECoreArnold/NodeAlgo.h"
@@ -625,42 +627,28 @@ class ShaderCache : public IECore::RefCounted
 		// Can be called concurrently with other get() calls.
 		ArnoldShaderPtr get( const IECoreScene::ShaderNetwork *shader )
 		{
-			Cache::accessor a;
-			m_cache.insert( a, shader->Object::hash() );
-			if( !a->second )
-			{
-				const std::string namePrefix = "shader:" + a->first.toString() + ":";
-				a->second = new ArnoldShader( shader, m_nodeDeleter, namePrefix, m_parentNode );
-			}
-			return a->second;
+			return m_cache.get(
+				shader,
+				[this]( const IECoreScene::ShaderNetwork *shader, const IECore::MurmurHash &hash ) {
+					const std::string namePrefix = "shader:" + hash.toString() + ":";
+					return new ArnoldShader( shader, m_nodeDeleter, namePrefix, m_parentNode );
+				}
+			);
 		}
 
 		// Must not be called concurrently with anything.
 		void clearUnused()
 		{
-			vector<IECore::MurmurHash> toErase;
-			for( Cache::iterator it = m_cache.begin(), eIt = m_cache.end(); it != eIt; ++it )
-			{
-				if( it->second->refCount() == 1 )
-				{
-					// Only one reference - this is ours, so
-					// nothing outside of the cache is using the
-					// shader.
-					toErase.push_back( it->first );
-				}
-			}
-			for( vector<IECore::MurmurHash>::const_iterator it = toErase.begin(), eIt = toErase.end(); it != eIt; ++it )
-			{
-				m_cache.erase( *it );
-			}
+			m_cache.clearUnused();
 		}
 
 		void nodesCreated( vector<AtNode *> &nodes ) const
 		{
-			for( Cache::const_iterator it = m_cache.begin(), eIt = m_cache.end(); it != eIt; ++it )
-			{
-				it->second->nodesCreated( nodes );
-			}
+			m_cache.forEach(
+				[&nodes]( const ArnoldShader *shader ) {
+					shader->nodesCreated( nodes );
+				}
+			);
 		}
 
 	private :
@@ -668,8 +656,7 @@ class ShaderCache : public IECore::RefCounted
 		NodeDeleter m_nodeDeleter;
 		AtNode *m_parentNode;
 
-		typedef tbb::concurrent_hash_map<IECore::MurmurHash, ArnoldShaderPtr> Cache;
-		Cache m_cache;
+		IECoreScenePreview::ShaderCache<ArnoldShader> m_cache;
 };
 
 IE_CORE_DECLAREPTR( ShaderCache )
@@ -683,12 +670,15 @@ class LightListCache : public IECore::RefCounted
 
 	public :
 
-		const std::vector<AtNode *> &get( const IECore::StringVectorData *nodeNamesData )
+		LightListCache()
+			:	m_hashCache( hashGetter, 10000 )
 		{
-			IECore::MurmurHash h = nodeNamesData->Object::hash();
+		}
 
+		const std::vector<AtNode *> &get( const IECore::StringVectorData *nodeNamesData )
+		{
 			Cache::accessor a;
-			m_cache.insert( a, h );
+			m_cache.insert( a, m_hashCache.get( nodeNamesData ).second );
 
 			if( a->second.empty() )
 			{
@@ -714,12 +704,30 @@ class LightListCache : public IECore::RefCounted
 		void clear()
 		{
 			m_cache.clear();
+			m_hashCache.clear();
 		}
 
 	private :
 
 		typedef tbb::concurrent_hash_map<IECore::MurmurHash, std::vector<AtNode *>> Cache;
 		Cache m_cache;
+
+		// A single list is typically shared by every location it applies
+		// to, so we memoise hashes by address rather than rehashing what
+		// may be thousands of names for every object. We hold a reference
+		// to each list so that its address can't be reused while memoised,
+		// and use an LRUCache so that we don't keep every list alive until
+		// the next call to `clear()`, which is only made by batch renders.
+		typedef std::pair<IECore::ConstStringVectorDataPtr, IECore::MurmurHash> HashCacheEntry;
+		typedef IECorePreview::LRUCache<const IECore::StringVectorData *, HashCacheEntry> HashCache;
+		HashCache m_hashCache;
+
+		static HashCacheEntry hashGetter( const IECore::StringVectorData *nodeNamesData, size_t &cost )
+		{
+			cost = 1;
+			return HashCacheEntry( nodeNamesData, nodeNamesData->Object::hash() );
+		}
+
 };
 
 IE_CORE_DECLAREPTR( LightListCache )
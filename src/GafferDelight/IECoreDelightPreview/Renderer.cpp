@@ -39,6 +39,8 @@
 #include "GafferDelight/IECoreDelightPreview/NodeAlgo.h"
 #include "GafferDelight/IECoreDelightPreview/ParameterList.h"
 
+#include "GafferScene/Private/IECoreScenePreview/ShaderCache.h"
+
 #include "IECoreScene/Shader.h"
 #include "IECoreScene/ShaderNetwork.h"
 #include "IECoreScene/ShaderNetworkAlgo.h"
@@ -483,16 +485,14 @@ class ShaderCache : public IECore::RefCounted
 		// Can be called concurrently with other get() calls.
 		DelightShaderPtr get( const IECoreScene::ShaderNetwork *shader )
 		{
-			Cache::accessor a;
-			m_cache.insert( a, shader ? shader->Object::hash() : MurmurHash() );
-			if( !a->second )
-			{
-				if( shader )
-				{
-					a->second = new DelightShader( m_context, shader, m_ownership );
-				}
-				else
-				{
+			return m_cache.get(
+				shader,
+				[this]( const IECoreScene::ShaderNetwork *shader, const IECore::MurmurHash & ) {
+					if( shader )
+					{
+						return new DelightShader( m_context, shader, m_ownership );
+					}
+
 					ShaderNetworkPtr defaultSurfaceNetwork = new ShaderNetwork;
 					/// \todo Use a shader that comes with 3delight, and provide
 					/// the expected "defaultsurface" facing ratio shading. The
@@ -502,10 +502,9 @@ class ShaderCache : public IECore::RefCounted
 					ShaderPtr defaultSurfaceShader = new Shader( "Surface/Constant", "surface" );
 					defaultSurfaceNetwork->addShader( "surface", std::move( defaultSurfaceShader ) );
 					defaultSurfaceNetwork->setOutput( { "surface" } );
-					a->second = new DelightShader( m_context, defaultSurfaceNetwork.get(), m_ownership );
+					return new DelightShader( m_context, defaultSurfaceNetwork.get(), m_ownership );
 				}
-			}
-			return a->second;
+			);
 		}
 
 		DelightShaderPtr defaultSurface()
@@ -516,21 +515,7 @@ class ShaderCache : public IECore::RefCounted
 		// Must not be called concurrently with anything.
 		void clearUnused()
 		{
-			vector<IECore::MurmurHash> toErase;
-			for( Cache::iterator it = m_cache.begin(), eIt = m_cache.end(); it != eIt; ++it )
-			{
-				if( it->second->refCount() == 1 )
-				{
-					// Only one reference - this is ours, so
-					// nothing outside of the cache is using the
-					// shader.
-					toErase.push_back( it->first );
-				}
-			}
-			for( vector<IECore::MurmurHash>::const_iterator it = toErase.begin(), eIt = toErase.end(); it != eIt; ++it )
-			{
-				m_cache.erase( *it );
-			}
+			m_cache.clearUnused();
 		}
 
 	private :
@@ -538,8 +523,7 @@ class ShaderCache : public IECore::RefCounted
 		NSIContext_t m_context;
 		DelightHandle::Ownership m_ownership;
 
-		typedef tbb::concurrent_hash_map<IECore::MurmurHash, DelightShaderPtr> Cache;
-		Cache m_cache;
+		IECoreScenePreview::ShaderCache<DelightShader> m_cache;
 
 };
 
@@ -44,6 +44,7 @@
 #include "Gaffer/Node.h"
 #include "Gaffer/PerformanceMonitor.h"
 #include "Gaffer/Plug.h"
+#include "Gaffer/TraceMonitor.h"
 #include "Gaffer/VTuneMonitor.h"
 
 #include "IECorePython/RefCountedBinding.h"
@@ -122,6 +123,48 @@ list contextMonitorVariableNames( const ContextMonitor::Statistics &s )
 	return result;
 }
 
+PlugPtr traceEventPlug( const TraceMonitor::Event &e )
+{
+	return const_cast<Plug *>( e.plug );
+}
+
+std::string traceEventType( const TraceMonitor::Event &e )
+{
+	return e.type.string();
+}
+
+boost::chrono::nanoseconds::rep traceEventStart( const TraceMonitor::Event &e )
+{
+	return e.start.count();
+}
+
+boost::chrono::nanoseconds::rep traceEventDuration( const TraceMonitor::Event &e )
+{
+	return e.duration.count();
+}
+
+object traceEventParent( const TraceMonitor::Event &e )
+{
+	return e.parent != TraceMonitor::Event::noParent ? object( e.parent ) : object();
+}
+
+list traceMonitorEvents( const TraceMonitor &m )
+{
+	list result;
+	const TraceMonitor::Events events = m.events();
+	for( const auto &e : events )
+	{
+		result.append( e );
+	}
+	return result;
+}
+
+void writeTraceWrapper( const TraceMonitor &m, const std::string &fileName )
+{
+	IECorePython::ScopedGILRelease gilRelease;
+	m.writeTrace( fileName );
+}
+
 void annotateWrapper1( Node &root, const PerformanceMonitor &monitor )
 {
 	IECorePython::ScopedGILRelease gilRelease;
@@ -181,6 +224,15 @@ void GafferModule::bindMonitor()
 			)
 		);
 
+		def(
+			"formatStatistics",
+			( std::string (*)( const TraceMonitor &, size_t ) )&formatStatistics,
+			(
+				arg( "monitor" ),
+				arg( "maxLinesPerMetric" ) = 50
+			)
+		);
+
 		def(
 			"annotate",
 			&annotateWrapper1,
@@ -252,6 +304,25 @@ void GafferModule::bindMonitor()
 		;
 	}
 
+	{
+		scope s = IECorePython::RefCountedClass<TraceMonitor, Monitor>( "TraceMonitor" )
+			.def( init<size_t>( arg( "maxEventsPerThread" ) = 1000000 ) )
+			.def( "events", &traceMonitorEvents )
+			.def( "numDiscardedEvents", &TraceMonitor::numDiscardedEvents )
+			.def( "writeTrace", &writeTraceWrapper, arg( "fileName" ) )
+		;
+
+		class_<TraceMonitor::Event>( "Event", no_init )
+			.add_property( "plug", &traceEventPlug )
+			.add_property( "type", &traceEventType )
+			.add_property( "contextHash", make_getter( &TraceMonitor::Event::contextHash, return_value_policy<return_by_value>() ) )
+			.def_readonly( "threadIndex", &TraceMonitor::Event::threadIndex )
+			.add_property( "start", &traceEventStart )
+			.add_property( "duration", &traceEventDuration )
+			.add_property( "parent", &traceEventParent )
+		;
+	}
+
 #ifdef GAFFER_VTUNE
 	{
 		scope s = IECorePython::RefCountedClass<VTuneMonitor, Monitor>( "VTuneMonitor" )
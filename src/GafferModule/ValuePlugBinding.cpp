@@ -100,11 +100,37 @@ void hash2( ValuePlug *plug, IECore::MurmurHash &h )
 }
 
 
+boost::chrono::nanoseconds::rep getComputeWaitDuration( const ValuePlug::CacheStatistics &s )
+{
+	return s.computeWaitDuration.count();
+}
+
+void setComputeWaitDuration( ValuePlug::CacheStatistics &s, boost::chrono::nanoseconds::rep v )
+{
+	s.computeWaitDuration = boost::chrono::nanoseconds( v );
+}
+
+dict cacheStatistics()
+{
+	const ValuePlug::CacheStatisticsMap statistics = ValuePlug::cacheStatistics();
+
+	dict result;
+	for( const auto &s : statistics )
+	{
+		const tuple key = make_tuple(
+			s.first.first == IECore::InvalidTypeId ? "" : IECore::RunTimeTyped::typeNameFromTypeId( s.first.first ),
+			IECore::RunTimeTyped::typeNameFromTypeId( s.first.second )
+		);
+		result[key] = s.second;
+	}
+	return result;
+}
+
 } // namespace
 
 void GafferModule::bindValuePlug()
 {
-	PlugClass<ValuePlug, PlugWrapper<ValuePlug> >()
+	scope s = PlugClass<ValuePlug, PlugWrapper<ValuePlug> >()
 		.def( boost::python::init<const std::string &, Plug::Direction, unsigned>(
 				(
 					boost::python::arg_( "name" ) = GraphComponent::defaultName<ValuePlug>(),
@@ -131,8 +157,27 @@ void GafferModule::bindValuePlug()
 		.staticmethod( "getHashCacheSizeLimit" )
 		.def( "setHashCacheSizeLimit", &ValuePlug::setHashCacheSizeLimit )
 		.staticmethod( "setHashCacheSizeLimit" )
+		.def( "setCacheStatisticsEnabled", &ValuePlug::setCacheStatisticsEnabled )
+		.staticmethod( "setCacheStatisticsEnabled" )
+		.def( "getCacheStatisticsEnabled", &ValuePlug::getCacheStatisticsEnabled )
+		.staticmethod( "getCacheStatisticsEnabled" )
+		.def( "cacheStatistics", &cacheStatistics )
+		.staticmethod( "cacheStatistics" )
+		.def( "resetCacheStatistics", &ValuePlug::resetCacheStatistics )
+		.staticmethod( "resetCacheStatistics" )
 		.def( "__repr__", &repr )
 	;
 
+	class_<ValuePlug::CacheStatistics>( "CacheStatistics" )
+		.def_readwrite( "computeHits", &ValuePlug::CacheStatistics::computeHits )
+		.def_readwrite( "computeMisses", &ValuePlug::CacheStatistics::computeMisses )
+		.def_readwrite( "computeEvictions", &ValuePlug::CacheStatistics::computeEvictions )
+		.def_readwrite( "computeMemoryUsage", &ValuePlug::CacheStatistics::computeMemoryUsage )
+		.add_property( "computeWaitDuration", &getComputeWaitDuration, &setComputeWaitDuration )
+		.def_readwrite( "hashHits", &ValuePlug::CacheStatistics::hashHits )
+		.def_readwrite( "hashMisses", &ValuePlug::CacheStatistics::hashMisses )
+		.def( self += self )
+	;
+
 	Serialisation::registerSerialiser( Gaffer::ValuePlug::staticTypeId(), new ValuePlugSerialiser );
 }
@@ -201,7 +201,10 @@ void EvaluateLightLinks::hashAttributes( const ScenePath &path, const Gaffer::Co
 	SceneProcessor::hashAttributes( path, context, parent, h );
 	h.append( inputHash );
 
-	Context::EditableScope scope( context );
+	// The light names depend only on the expression and the sets, so
+	// we evaluate them in a global context. This allows them to be
+	// computed once per unique expression, rather than once per location.
+	ScenePlug::GlobalScope scope( context );
 
 	if( illuminationExpressionData || path.size() == 1 )
 	{
@@ -259,7 +262,7 @@ IECore::ConstCompoundObjectPtr EvaluateLightLinks::computeAttributes( const Scen
 	CompoundObjectPtr result = new CompoundObject;
 	result->members() = inputAttributes->members();
 
-	Context::EditableScope scope( context );
+	ScenePlug::GlobalScope scope( context );
 
 	if( illuminationExpressionData || path.size() == 1 )
 	{
@@ -47,6 +47,7 @@
 #include "IECoreGL/Exception.h"
 #include "IECoreGL/FrameBuffer.h"
 #include "IECoreGL/GL.h"
+#include "IECoreGL/Group.h"
 #include "IECoreGL/PointsPrimitive.h"
 #include "IECoreGL/Primitive.h"
 #include "IECoreGL/Renderable.h"
@@ -56,6 +57,7 @@
 #include "IECoreGL/ToGLCameraConverter.h"
 #include "IECoreGL/IECoreGL.h"
 
+#include "IECore/CompoundData.h"
 #include "IECore/CompoundParameter.h"
 #include "IECore/MessageHandler.h"
 #include "IECore/PathMatcherData.h"
@@ -66,11 +68,15 @@
 #include "OpenEXR/ImathBoxAlgo.h"
 
 #include "boost/algorithm/string/predicate.hpp"
+#include "boost/chrono.hpp"
 #include "boost/format.hpp"
 
 #include "tbb/concurrent_queue.h"
 
 #include <functional>
+#include <limits>
+#include <map>
+#include <tuple>
 #include <unordered_map>
 #include <vector>
 
@@ -133,6 +139,127 @@ const IECoreGL::State &selectionState()
 	return *s;
 }
 
+// A wireframe unit cube, used to draw objects at the lowest
+// level of detail.
+const IECoreGL::Renderable *boundRenderable()
+{
+	static IECoreGL::GroupPtr g;
+	if( !g )
+	{
+		g = new IECoreGL::Group;
+		g->getState()->add( new IECoreGL::Primitive::DrawWireframe( true ) );
+		g->getState()->add( new IECoreGL::Primitive::DrawSolid( false ) );
+		g->getState()->add( new IECoreGL::CurvesPrimitive::UseGLLines( true ) );
+
+		IECore::V3fVectorDataPtr pData = new IECore::V3fVectorData;
+		vector<V3f> &p = pData->writable();
+		for( int axis = 0; axis < 3; ++axis )
+		{
+			for( int i = 0; i < 4; ++i )
+			{
+				V3f v( 0 );
+				v[(axis+1)%3] = i & 1;
+				v[(axis+2)%3] = ( i >> 1 ) & 1;
+				p.push_back( v );
+				v[axis] = 1;
+				p.push_back( v );
+			}
+		}
+
+		IECore::IntVectorDataPtr vertsPerCurve = new IECore::IntVectorData;
+		vertsPerCurve->writable().resize( 12, 2 );
+
+		IECoreGL::CurvesPrimitivePtr curves = new IECoreGL::CurvesPrimitive( IECore::CubicBasisf::linear(), false, vertsPerCurve );
+		curves->addPrimitiveVariable( "P", IECoreScene::PrimitiveVariable( IECoreScene::PrimitiveVariable::Vertex, pData ) );
+		g->addChild( curves );
+	}
+	return g.get();
+}
+
+// Projects bounding boxes using the current OpenGL matrices,
+// to determine their visibility and size on screen.
+class ScreenProjection
+{
+
+	public :
+
+		ScreenProjection()
+		{
+			M44f modelView, projection;
+			glGetFloatv( GL_MODELVIEW_MATRIX, modelView.getValue() );
+			glGetFloatv( GL_PROJECTION_MATRIX, projection.getValue() );
+			m_matrix = modelView * projection;
+
+			GLint viewport[4];
+			glGetIntegerv( GL_VIEWPORT, viewport );
+			m_viewportSize = V2f( viewport[2], viewport[3] );
+		}
+
+		const M44f &matrix() const
+		{
+			return m_matrix;
+		}
+
+		// Returns false if the box is entirely outside the view
+		// frustum. Otherwise returns true, and fills `screenSize`
+		// with the size of the box on screen in pixels. Boxes
+		// which cross the eye plane are considered infinitely large.
+		bool project( const Box3f &box, float &screenSize ) const
+		{
+			// Bitmask of the clipping planes which all
+			// corners are outside of.
+			unsigned outside = 0x3f;
+			bool behindEye = false;
+			Box2f ndcBox;
+			for( int i = 0; i < 8; ++i )
+			{
+				const V4f c = V4f(
+					i & 1 ? box.max.x : box.min.x,
+					i & 2 ? box.max.y : box.min.y,
+					i & 4 ? box.max.z : box.min.z,
+					1.0f
+				) * m_matrix;
+
+				outside &=
+					( c.x < -c.w ? 1 : 0 ) | ( c.x > c.w ? 2 : 0 ) |
+					( c.y < -c.w ? 4 : 0 ) | ( c.y > c.w ? 8 : 0 ) |
+					( c.z < -c.w ? 16 : 0 ) | ( c.z > c.w ? 32 : 0 )
+				;
+
+				if( c.w > 0.0f )
+				{
+					ndcBox.extendBy( V2f( c.x / c.w, c.y / c.w ) );
+				}
+				else
+				{
+					behindEye = true;
+				}
+			}
+
+			if( outside )
+			{
+				return false;
+			}
+
+			if( behindEye )
+			{
+				screenSize = std::numeric_limits<float>::infinity();
+			}
+			else
+			{
+				const V2f size = ndcBox.size() * m_viewportSize * 0.5f;
+				screenSize = std::max( size.x, size.y );
+			}
+			return true;
+		}
+
+	private :
+
+		M44f m_matrix;
+		V2f m_viewportSize;
+
+};
+
 } // namespace
 
 //////////////////////////////////////////////////////////////////////////
@@ -202,6 +329,8 @@ class OpenGLObject : public IECoreScenePreview::Renderer::ObjectInterface
 		OpenGLObject( const std::string &name, const IECore::Object *object, const ConstOpenGLAttributesPtr &attributes, EditQueue &editQueue )
 			:	m_objectType( object ? object->typeId() : IECore::NullObjectTypeId ),
 				m_attributes( attributes ),
+				m_boundDirty( true ),
+				m_fullDetailFrame( 0 ),
 				m_editQueue( editQueue )
 		{
 			IECore::StringAlgo::tokenize( name, '/', m_name );
@@ -231,6 +360,7 @@ class OpenGLObject : public IECoreScenePreview::Renderer::ObjectInterface
 		{
 			m_editQueue.push( [this, transform]() {
 				m_transform = transform;
+				m_boundDirty = true;
 			} );
 		}
 
@@ -244,28 +374,24 @@ class OpenGLObject : public IECoreScenePreview::Renderer::ObjectInterface
 			ConstOpenGLAttributesPtr openGLAttributes = static_cast<const OpenGLAttributes *>( attributes );
 			m_editQueue.push( [this, openGLAttributes]() {
 				m_attributes = openGLAttributes;
+				m_boundDirty = true;
 			} );
 			return true;
 		}
 
-		Box3f transformedBound() const
+		// Bounds are cached, because they are needed for every
+		// object on every redraw. Must only be called on the
+		// render thread.
+		const Box3f &bound() const
 		{
-			Box3f b;
-			if( m_renderable )
-			{
-				b.extendBy( m_renderable->bound() );
-			}
-			if( m_attributes->visualisation() )
-			{
-				b.extendBy( m_attributes->visualisation()->bound() );
-			}
-
-			if( b.isEmpty() )
-			{
-				return b;
-			}
+			updateBounds();
+			return m_bound;
+		}
 
-			return Imath::transform( b, m_transform );
+		const Box3f &transformedBound() const
+		{
+			updateBounds();
+			return m_transformedBound;
 		}
 
 		const vector<InternedString> &name() const
@@ -278,7 +404,12 @@ class OpenGLObject : public IECoreScenePreview::Renderer::ObjectInterface
 			return selection.match( m_name ) & ( PathMatcher::AncestorMatch | PathMatcher::ExactMatch );
 		}
 
-		void render( IECoreGL::State *currentState, const IECore::PathMatcher &selection ) const
+		// Renders the object. The caller is responsible for binding
+		// `state()` and the selection state, so that objects sharing
+		// the same state can be drawn with a single binding. If
+		// `drawBound` is true, the bounding box is drawn in place of
+		// the object itself.
+		void render( IECoreGL::State *currentState, bool drawBound ) const
 		{
 			const bool haveTransform = m_transform != M44f();
 			if( haveTransform )
@@ -287,17 +418,29 @@ class OpenGLObject : public IECoreScenePreview::Renderer::ObjectInterface
 				glMultMatrixf( m_transform.getValue() );
 			}
 
-			IECoreGL::State::ScopedBinding scope( *m_attributes->state(), *currentState );
-			IECoreGL::State::ScopedBinding selectionScope( selectionState(), *currentState, selected( selection ) );
-
-			if( m_renderable )
+			if( drawBound )
 			{
-				m_renderable->render( currentState );
+				const Box3f &b = bound();
+				if( !b.isEmpty() )
+				{
+					const M44f boundMatrix = M44f().setScale( b.size() ) * M44f().setTranslation( b.min );
+					glPushMatrix();
+					glMultMatrixf( boundMatrix.getValue() );
+					boundRenderable()->render( currentState );
+					glPopMatrix();
+				}
 			}
-
-			if( m_attributes->visualisation() )
+			else
 			{
-				m_attributes->visualisation()->render( currentState );
+				if( m_renderable )
+				{
+					m_renderable->render( currentState );
+				}
+
+				if( m_attributes->visualisation() )
+				{
+					m_attributes->visualisation()->render( currentState );
+				}
 			}
 
 			if( haveTransform )
@@ -306,6 +449,34 @@ class OpenGLObject : public IECoreScenePreview::Renderer::ObjectInterface
 			}
 		}
 
+		const IECoreGL::State *state() const
+		{
+			return m_attributes->state();
+		}
+
+		// The last frame in which the object was drawn in full,
+		// or 0 if it has never been. Used by the renderer to track
+		// progressive refinement.
+		size_t getFullDetailFrame() const
+		{
+			return m_fullDetailFrame;
+		}
+
+		void setFullDetailFrame( size_t frame ) const
+		{
+			m_fullDetailFrame = frame;
+		}
+
+		const IECoreGL::Renderable *renderable() const
+		{
+			return m_renderable.get();
+		}
+
+		const IECoreGL::Renderable *visualisation() const
+		{
+			return m_attributes->visualisation();
+		}
+
 		IECore::TypeId objectType() const
 		{
 			return m_objectType;
@@ -320,11 +491,36 @@ class OpenGLObject : public IECoreScenePreview::Renderer::ObjectInterface
 
 	private :
 
+		void updateBounds() const
+		{
+			if( !m_boundDirty )
+			{
+				return;
+			}
+
+			m_bound = Box3f();
+			if( m_renderable )
+			{
+				m_bound.extendBy( m_renderable->bound() );
+			}
+			if( m_attributes->visualisation() )
+			{
+				m_bound.extendBy( m_attributes->visualisation()->bound() );
+			}
+
+			m_transformedBound = m_bound.isEmpty() ? m_bound : Imath::transform( m_bound, m_transform );
+			m_boundDirty = false;
+		}
+
 		IECore::TypeId m_objectType;
 		M44f m_transform;
 		ConstOpenGLAttributesPtr m_attributes;
 		IECoreGL::ConstRenderablePtr m_renderable;
 		vector<InternedString> m_name;
+		mutable Box3f m_bound;
+		mutable Box3f m_transformedBound;
+		mutable bool m_boundDirty;
+		mutable size_t m_fullDetailFrame;
 		EditQueue &m_editQueue;
 
 };
@@ -404,7 +600,10 @@ class OpenGLRenderer final : public IECoreScenePreview::Renderer
 	public :
 
 		OpenGLRenderer( RenderType renderType, const std::string &fileName )
-			:	m_renderType( renderType ), m_baseStateOptions( new CompoundObject )
+			:	m_renderType( renderType ), m_baseStateOptions( new CompoundObject ),
+				m_culling( true ), m_minimumScreenSize( 0.0f ), m_frameBudget( 0.0f ),
+				m_frame( 1 ), m_editsPending( false ), m_renderComplete( true ),
+				m_numObjectsCulled( 0 ), m_numObjectsDrawn( 0 ), m_numBoundsDrawn( 0 )
 		{
 			if( renderType == SceneDescription )
 			{
@@ -453,6 +652,42 @@ class OpenGLRenderer final : public IECoreScenePreview::Renderer
 				}
 				return;
 			}
+			else if( name == "gl:culling" )
+			{
+				m_culling = true;
+				if( value )
+				{
+					if( auto d = reportedCast<const IECore::BoolData>( value, "option", name ) )
+					{
+						m_culling = d->readable();
+					}
+				}
+				return;
+			}
+			else if( name == "gl:lod:minimumScreenSize" )
+			{
+				m_minimumScreenSize = 0.0f;
+				if( value )
+				{
+					if( auto d = reportedCast<const IECore::FloatData>( value, "option", name ) )
+					{
+						m_minimumScreenSize = d->readable();
+					}
+				}
+				return;
+			}
+			else if( name == "gl:frameBudget" )
+			{
+				m_frameBudget = 0.0f;
+				if( value )
+				{
+					if( auto d = reportedCast<const IECore::FloatData>( value, "option", name ) )
+					{
+						m_frameBudget = d->readable();
+					}
+				}
+				return;
+			}
 			else if(
 				boost::starts_with( name.string(), "gl:primitive:" ) ||
 				boost::starts_with( name.string(), "gl:pointsPrimitive:" ) ||
@@ -561,6 +796,18 @@ class OpenGLRenderer final : public IECoreScenePreview::Renderer
 			{
 				return querySelectedObjects( parameters );
 			}
+			else if( name == "gl:queryRenderComplete" )
+			{
+				return new BoolData( m_renderComplete );
+			}
+			else if( name == "gl:queryRenderStatistics" )
+			{
+				CompoundDataPtr result = new CompoundData;
+				result->writable()["objectsCulled"] = new UInt64Data( m_numObjectsCulled );
+				result->writable()["objectsDrawn"] = new UInt64Data( m_numObjectsDrawn );
+				result->writable()["boundsDrawn"] = new UInt64Data( m_numBoundsDrawn );
+				return result;
+			}
 
 			throw IECore::Exception( "Unknown command" );
 		}
@@ -569,10 +816,31 @@ class OpenGLRenderer final : public IECoreScenePreview::Renderer
 
 		void renderInteractive()
 		{
-			processQueue();
-			removeDeletedObjects();
+			// All conversion of objects to IECoreGL primitives happens on the
+			// threads calling `object()`. All that remains for us is to hook
+			// the results into the render state, which we time-slice so that
+			// huge scene updates can't freeze the UI. The first draw of each
+			// object uploads its buffers to the GPU, which is time-sliced in
+			// turn by `renderObjects()`, using whatever remains of the frame
+			// budget.
+			typedef boost::chrono::steady_clock Clock;
+			const Clock::time_point frameStart = Clock::now();
+			m_editsPending = !processQueue( m_frameBudget );
+			if( !m_editsPending )
+			{
+				// Edits for objects that the client has already released
+				// may still be queued, and they refer to the objects by
+				// raw pointer. So we can only delete objects once the
+				// queue has been drained.
+				removeDeletedObjects();
+			}
 			CachedConverter::defaultCachedConverter()->clearUnused();
 
+			const float drawBudget = std::max(
+				m_frameBudget - boost::chrono::duration<float>( Clock::now() - frameStart ).count(),
+				0.0f
+			);
+
 			GLint prevProgram;
 			glGetIntegerv( GL_CURRENT_PROGRAM, &prevProgram );
 			glPushAttrib( GL_ALL_ATTRIB_BITS );
@@ -607,7 +875,7 @@ class OpenGLRenderer final : public IECoreScenePreview::Renderer
 				}
 				else
 				{
-					renderObjects( state );
+					renderObjects( state, drawBudget );
 				}
 
 			glPopAttrib();
@@ -664,7 +932,7 @@ class OpenGLRenderer final : public IECoreScenePreview::Renderer
 
 				camera->camera()->render( state );
 
-				renderObjects( state );
+				renderObjects( state, m_frameBudget );
 
 				writeOutputs( frameBuffer.get() );
 
@@ -672,13 +940,28 @@ class OpenGLRenderer final : public IECoreScenePreview::Renderer
 			glUseProgram( prevProgram );
 		}
 
-		void processQueue()
+		// Applies edits from the queue. If `budget` is non-zero, stops
+		// once that many seconds have elapsed, returning false if
+		// edits remain.
+		bool processQueue( float budget = 0.0f )
 		{
+			typedef boost::chrono::steady_clock Clock;
+			const Clock::time_point start = Clock::now();
+			const boost::chrono::duration<float> budgetDuration( budget );
+
 			Edit edit;
+			size_t numEdits = 0;
 			while( m_editQueue.try_pop( edit ) )
 			{
 				edit();
+				// Checking the clock is more expensive than the
+				// typical edit, so we only do it periodically.
+				if( budget > 0.0f && ( ++numEdits % 1000 ) == 0 && Clock::now() - start > budgetDuration )
+				{
+					return m_editQueue.empty();
+				}
 			}
+			return true;
 		}
 
 		// During interactive renders, the client code controls the lifetime
@@ -722,18 +1005,162 @@ class OpenGLRenderer final : public IECoreScenePreview::Renderer
 			);
 		}
 
-		void renderObjects( IECoreGL::State *currentState )
+		// Draws all objects. When `gl:frameBudget` is in effect, objects not
+		// drawn in full on the previous frame are drawn in full only until
+		// `drawBudget` seconds have been used.
+		void renderObjects( IECoreGL::State *currentState, float drawBudget = 0.0f )
 		{
 			IECoreGL::Selector *selector = IECoreGL::Selector::currentSelector();
 
-			GLuint i = 1;
+			// Cull objects outside the frustum, and measure the size of
+			// the remainder on screen, so we can choose a level of detail.
+
+			const ScreenProjection projection;
+			const bool measure = m_culling || m_minimumScreenSize > 0.0f || m_frameBudget > 0.0f;
+
+			struct VisibleObject
+			{
+				const OpenGLObject *object;
+				GLuint name;
+				float screenSize;
+				bool drawBound;
+			};
+
+			vector<VisibleObject> visibleObjects;
+			visibleObjects.reserve( m_objects.size() );
+			GLuint name = 1;
+			size_t numObjectsCulled = 0;
 			for( const auto &o : m_objects )
 			{
-				if( selector )
+				float screenSize = std::numeric_limits<float>::infinity();
+				const Box3f b = measure ? o->transformedBound() : Box3f();
+				if( !b.isEmpty() && !projection.project( b, screenSize ) && m_culling )
+				{
+					numObjectsCulled++;
+					name++;
+					continue;
+				}
+				visibleObjects.push_back( { o.get(), name++, screenSize, screenSize < m_minimumScreenSize } );
+			}
+
+			// When we have a budget, we draw the largest objects first, and
+			// once the budget is used up, draw the remainder as bounding boxes.
+			// Each subsequent redraw of an unchanged view draws everything that
+			// was drawn in full last time, plus as much more as the budget
+			// allows, progressively refining the image. Selection is never
+			// budgeted, since it must be accurate.
+
+			const bool budgeted = m_frameBudget > 0.0f && !selector;
+			const bool viewUnchanged = projection.matrix() == m_previousProjectionMatrix;
+			if( budgeted )
+			{
+				std::stable_sort(
+					visibleObjects.begin(), visibleObjects.end(),
+					[] ( const VisibleObject &a, const VisibleObject &b ) {
+						return a.screenSize > b.screenSize;
+					}
+				);
+			}
+
+			// Group objects which draw the same renderables with the same
+			// state, so that we can bind the state once per group rather than
+			// once per object. CachedConverter shares renderables and states
+			// between identical objects and attributes, so this collapses
+			// repeated geometry such as the output of an Instancer into a
+			// handful of groups. Groups are ordered by their first member, so
+			// budgeted renders still start with the largest objects.
+
+			struct DrawGroup
+			{
+				const IECoreGL::State *state;
+				bool selected;
+				vector<const VisibleObject *> members;
+			};
+
+			typedef std::tuple<const IECoreGL::State *, const IECoreGL::Renderable *, const IECoreGL::Renderable *, bool> DrawGroupKey;
+			std::map<DrawGroupKey, size_t> drawGroupIndices;
+			vector<DrawGroup> drawGroups;
+			for( const auto &v : visibleObjects )
+			{
+				const bool selected = v.object->selected( m_selection );
+				const DrawGroupKey key(
+					v.object->state(),
+					v.drawBound ? boundRenderable() : v.object->renderable(),
+					v.drawBound ? nullptr : v.object->visualisation(),
+					selected
+				);
+				auto inserted = drawGroupIndices.insert( { key, drawGroups.size() } );
+				if( inserted.second )
+				{
+					drawGroups.push_back( { v.object->state(), selected, {} } );
+				}
+				drawGroups[inserted.first->second].members.push_back( &v );
+			}
+
+			typedef boost::chrono::steady_clock Clock;
+			const boost::chrono::duration<float> frameBudget( drawBudget );
+			Clock::duration budgetUsed( 0 );
+
+			bool complete = true;
+			size_t numBoundsDrawn = 0;
+			for( const auto &group : drawGroups )
+			{
+				IECoreGL::State::ScopedBinding scope( *group.state, *currentState );
+				IECoreGL::State::ScopedBinding selectionScope( selectionState(), *currentState, group.selected );
+
+				for( const VisibleObject *v : group.members )
 				{
-					selector->loadName( i++ );
+					bool drawBound = v->drawBound;
+					bool timed = false;
+					if( !drawBound && budgeted )
+					{
+						const size_t lastFrame = v->object->getFullDetailFrame();
+						if( !viewUnchanged || !lastFrame || lastFrame != m_frame - 1 )
+						{
+							if( budgetUsed > frameBudget )
+							{
+								drawBound = true;
+								complete = false;
+							}
+							else
+							{
+								timed = true;
+							}
+						}
+					}
+
+					if( selector )
+					{
+						selector->loadName( v->name );
+					}
+
+					const Clock::time_point start = timed ? Clock::now() : Clock::time_point();
+					v->object->render( currentState, drawBound );
+					if( timed )
+					{
+						budgetUsed += Clock::now() - start;
+					}
+
+					if( drawBound )
+					{
+						numBoundsDrawn++;
+					}
+					else if( !selector )
+					{
+						v->object->setFullDetailFrame( m_frame );
+					}
 				}
-				o->render( currentState, m_selection );
+			}
+
+			if( !selector )
+			{
+				m_previousProjectionMatrix = projection.matrix();
+				m_renderComplete = complete && !m_editsPending;
+				m_numObjectsCulled = numObjectsCulled;
+				m_numObjectsDrawn = visibleObjects.size() - numBoundsDrawn;
+				m_numBoundsDrawn = numBoundsDrawn;
+				// Frame 0 is reserved to mean "never drawn".
+				m_frame++;
 			}
 		}
 
@@ -864,6 +1291,20 @@ class OpenGLRenderer final : public IECoreScenePreview::Renderer
 		IECore::PathMatcher m_selection;
 		IECore::CompoundObjectPtr m_baseStateOptions;
 		IECoreGL::StatePtr m_baseState;
+		bool m_culling;
+		float m_minimumScreenSize;
+		float m_frameBudget;
+
+		// Progressive refinement state, updated by `renderObjects()`.
+		M44f m_previousProjectionMatrix;
+		size_t m_frame;
+		bool m_editsPending;
+		bool m_renderComplete;
+
+		// Object counts from the last frame, for `gl:queryRenderStatistics`.
+		size_t m_numObjectsCulled;
+		size_t m_numObjectsDrawn;
+		size_t m_numBoundsDrawn;
 
 		// Queue used to pass edits from background threads to the render thread.
 		EditQueue m_editQueue;
@@ -0,0 +1,423 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2019, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//      * Redistributions of source code must retain the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer.
+//
+//      * Redistributions in binary form must reproduce the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer in the documentation and/or other materials provided with
+//        the distribution.
+//
+//      * Neither the name of John Haddon nor the names of
+//        any other contributors to this software may be used to endorse or
+//        promote products derived from this software without specific prior
+//        written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+#include "GafferScene/Private/IECoreScenePreview/Renderer.h"
+#include "GafferScene/Private/IECoreScenePreview/ShaderCache.h"
+
+#include "IECore/Exception.h"
+#include "IECore/SimpleTypedData.h"
+
+#include "boost/chrono.hpp"
+
+#include "tbb/enumerable_thread_specific.h"
+
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+
+using namespace std;
+using namespace Imath;
+using namespace IECore;
+using namespace IECoreScene;
+using namespace IECoreScenePreview;
+
+//////////////////////////////////////////////////////////////////////////
+// Null renderer
+//
+// Accepts all calls without rendering anything, so that the cost of
+// generating a scene can be measured independently of the cost of the
+// renderer itself. Counts of each call and the number of bytes passed
+// are available via the "null:statistics" command. In SceneDescription
+// mode, a record of each call is written to the output file, sorted
+// by name so that the files from separate runs may be diffed to check
+// that they output identical scenes. Shader networks are passed through
+// the same ShaderCache used by the real backends, so that the number of
+// unique networks can be measured too.
+//////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+typedef boost::chrono::high_resolution_clock Clock;
+
+class NullRenderer;
+
+struct Statistics
+{
+
+	Statistics()
+		:	options( 0 ), outputs( 0 ), attributes( 0 ), cameras( 0 ), lights( 0 ), lightFilters( 0 ),
+			objects( 0 ), objectSamples( 0 ), transforms( 0 ), transformSamples( 0 ), attributeEdits( 0 ),
+			objectBytes( 0 ), attributeBytes( 0 )
+	{
+	}
+
+	std::atomic<uint64_t> options;
+	std::atomic<uint64_t> outputs;
+	std::atomic<uint64_t> attributes;
+	std::atomic<uint64_t> cameras;
+	std::atomic<uint64_t> lights;
+	std::atomic<uint64_t> lightFilters;
+	std::atomic<uint64_t> objects;
+	std::atomic<uint64_t> objectSamples;
+	std::atomic<uint64_t> transforms;
+	std::atomic<uint64_t> transformSamples;
+	std::atomic<uint64_t> attributeEdits;
+	std::atomic<uint64_t> objectBytes;
+	std::atomic<uint64_t> attributeBytes;
+
+};
+
+class NullAttributesInterface : public IECoreScenePreview::Renderer::AttributesInterface
+{
+
+	public :
+
+		NullAttributesInterface( const IECore::MurmurHash &hash, std::vector<ConstShaderNetworkPtr> &&shaders )
+			:	m_hash( hash ), m_shaders( std::move( shaders ) )
+		{
+		}
+
+		const IECore::MurmurHash &hash() const
+		{
+			return m_hash;
+		}
+
+	private :
+
+		// Only computed when recording.
+		const IECore::MurmurHash m_hash;
+		// References held on behalf of the ShaderCache.
+		const std::vector<ConstShaderNetworkPtr> m_shaders;
+
+};
+
+class NullObjectInterface : public IECoreScenePreview::Renderer::ObjectInterface
+{
+
+	public :
+
+		NullObjectInterface( NullRenderer *renderer, const std::string &name )
+			:	m_renderer( renderer ), m_name( name )
+		{
+		}
+
+		void transform( const Imath::M44f &transform ) override;
+		void transform( const std::vector<Imath::M44f> &samples, const std::vector<float> &times ) override;
+		bool attributes( const IECoreScenePreview::Renderer::AttributesInterface *attributes ) override;
+
+	private :
+
+		NullRenderer *m_renderer;
+		const std::string m_name;
+
+};
+
+class NullRenderer final : public IECoreScenePreview::Renderer
+{
+
+	public :
+
+		NullRenderer( RenderType renderType, const std::string &fileName )
+			:	m_fileName( renderType == SceneDescription ? fileName : "" ), m_startTime( Clock::now() )
+		{
+		}
+
+		~NullRenderer() override
+		{
+		}
+
+		IECore::InternedString name() const override
+		{
+			return "Null";
+		}
+
+		void option( const IECore::InternedString &name, const IECore::Object *value ) override
+		{
+			m_statistics.options++;
+			record( "option", name.string(), value );
+		}
+
+		void output( const IECore::InternedString &name, const IECoreScene::Output *output ) override
+		{
+			m_statistics.outputs++;
+			record( "output", name.string(), output );
+		}
+
+		Renderer::AttributesInterfacePtr attributes( const IECore::CompoundObject *attributes ) override
+		{
+			m_statistics.attributes++;
+			m_statistics.attributeBytes += attributes->memoryUsage();
+
+			std::vector<ConstShaderNetworkPtr> shaders;
+			for( const auto &a : attributes->members() )
+			{
+				if( auto network = runTimeCast<const ShaderNetwork>( a.second.get() ) )
+				{
+					shaders.push_back(
+						m_shaderCache.get(
+							network,
+							[]( const ShaderNetwork *network, const MurmurHash & ) {
+								return network;
+							}
+						)
+					);
+				}
+			}
+
+			return new NullAttributesInterface( recording() ? attributes->hash() : MurmurHash(), std::move( shaders ) );
+		}
+
+		ObjectInterfacePtr camera( const std::string &name, const IECoreScene::Camera *camera, const AttributesInterface *attributes ) override
+		{
+			m_statistics.cameras++;
+			return addObject( "camera", name, camera, attributes );
+		}
+
+		ObjectInterfacePtr light( const std::string &name, const IECore::Object *object, const AttributesInterface *attributes ) override
+		{
+			m_statistics.lights++;
+			return addObject( "light", name, object, attributes );
+		}
+
+		ObjectInterfacePtr lightFilter( const std::string &name, const IECore::Object *object, const AttributesInterface *attributes ) override
+		{
+			m_statistics.lightFilters++;
+			return addObject( "lightFilter", name, object, attributes );
+		}
+
+		Renderer::ObjectInterfacePtr object( const std::string &name, const IECore::Object *object, const AttributesInterface *attributes ) override
+		{
+			m_statistics.objects++;
+			m_statistics.objectSamples++;
+			return addObject( "object", name, object, attributes );
+		}
+
+		ObjectInterfacePtr object( const std::string &name, const std::vector<const IECore::Object *> &samples, const std::vector<float> &times, const AttributesInterface *attributes ) override
+		{
+			m_statistics.objects++;
+			m_statistics.objectSamples += samples.size();
+
+			IECore::MurmurHash h;
+			for( size_t i = 0; i < samples.size(); ++i )
+			{
+				m_statistics.objectBytes += samples[i]->memoryUsage();
+				if( recording() )
+				{
+					samples[i]->hash( h );
+					h.append( times[i] );
+				}
+			}
+
+			record( "object", name, h, attributes );
+			return new NullObjectInterface( this, name );
+		}
+
+		void render() override
+		{
+			if( m_renderTime == Clock::time_point() )
+			{
+				m_renderTime = Clock::now();
+			}
+			m_shaderCache.clearUnused();
+			writeRecords();
+		}
+
+		void pause() override
+		{
+		}
+
+		IECore::DataPtr command( const IECore::InternedString name, const IECore::CompoundDataMap &parameters ) override
+		{
+			if( name != "null:statistics" )
+			{
+				// We accept all commands, just as we accept all
+				// options and attributes.
+				return nullptr;
+			}
+
+			CompoundDataPtr result = new CompoundData;
+			CompoundDataMap &m = result->writable();
+			m["options"] = new UInt64Data( m_statistics.options );
+			m["outputs"] = new UInt64Data( m_statistics.outputs );
+			m["attributes"] = new UInt64Data( m_statistics.attributes );
+			m["cameras"] = new UInt64Data( m_statistics.cameras );
+			m["lights"] = new UInt64Data( m_statistics.lights );
+			m["lightFilters"] = new UInt64Data( m_statistics.lightFilters );
+			m["objects"] = new UInt64Data( m_statistics.objects );
+			m["objectSamples"] = new UInt64Data( m_statistics.objectSamples );
+			m["transforms"] = new UInt64Data( m_statistics.transforms );
+			m["transformSamples"] = new UInt64Data( m_statistics.transformSamples );
+			m["attributeEdits"] = new UInt64Data( m_statistics.attributeEdits );
+			m["objectBytes"] = new UInt64Data( m_statistics.objectBytes );
+			m["attributeBytes"] = new UInt64Data( m_statistics.attributeBytes );
+
+			const ShaderCache<const ShaderNetwork>::Statistics shaderStatistics = m_shaderCache.statistics();
+			m["shaderLookups"] = new UInt64Data( shaderStatistics.lookups );
+			m["shaderHashes"] = new UInt64Data( shaderStatistics.hashes );
+			m["shaders"] = new UInt64Data( shaderStatistics.conversions );
+
+			// Time from construction until the first call to `render()`, or
+			// until now if `render()` hasn't been called yet. This is the time
+			// taken to output the scene, which is what we're here to measure.
+			const Clock::time_point end = m_renderTime != Clock::time_point() ? m_renderTime : Clock::now();
+			m["time"] = new DoubleData( boost::chrono::duration<double>( end - m_startTime ).count() );
+
+			return result;
+		}
+
+	private :
+
+		friend class NullObjectInterface;
+
+		bool recording() const
+		{
+			return !m_fileName.empty();
+		}
+
+		ObjectInterfacePtr addObject( const char *type, const std::string &name, const IECore::Object *object, const AttributesInterface *attributes )
+		{
+			if( object )
+			{
+				m_statistics.objectBytes += object->memoryUsage();
+			}
+			record( type, name, object, attributes );
+			return new NullObjectInterface( this, name );
+		}
+
+		void record( const char *type, const std::string &name, const IECore::Object *object, const AttributesInterface *attributes = nullptr )
+		{
+			if( !recording() )
+			{
+				return;
+			}
+			record( type, name, object ? object->hash() : MurmurHash(), attributes );
+		}
+
+		void record( const char *type, const std::string &name, const IECore::MurmurHash &hash, const AttributesInterface *attributes = nullptr )
+		{
+			if( !recording() )
+			{
+				return;
+			}
+
+			std::string r = std::string( type ) + " " + name + " " + hash.toString();
+			if( attributes )
+			{
+				r += " " + static_cast<const NullAttributesInterface *>( attributes )->hash().toString();
+			}
+			m_records.local().push_back( r );
+		}
+
+		void writeRecords()
+		{
+			if( !recording() )
+			{
+				return;
+			}
+
+			// Calls may be made concurrently from many threads, so we
+			// sort the records to make the output independent of the
+			// order in which they arrived.
+			std::vector<std::string> records;
+			for( const auto &r : m_records )
+			{
+				records.insert( records.end(), r.begin(), r.end() );
+			}
+			std::sort( records.begin(), records.end() );
+
+			std::ofstream file( m_fileName );
+			if( !file.good() )
+			{
+				throw IECore::IOException( "Unable to open \"" + m_fileName + "\" for writing" );
+			}
+
+			for( const auto &r : records )
+			{
+				file << r << "\n";
+			}
+		}
+
+		const std::string m_fileName;
+		Statistics m_statistics;
+		ShaderCache<const ShaderNetwork> m_shaderCache;
+		tbb::enumerable_thread_specific<std::vector<std::string>> m_records;
+
+		const Clock::time_point m_startTime;
+		Clock::time_point m_renderTime;
+
+		static Renderer::TypeDescription<NullRenderer> g_typeDescription;
+
+};
+
+IECoreScenePreview::Renderer::TypeDescription<NullRenderer> NullRenderer::g_typeDescription( "Null" );
+
+void NullObjectInterface::transform( const Imath::M44f &transform )
+{
+	m_renderer->m_statistics.transforms++;
+	m_renderer->m_statistics.transformSamples++;
+	if( m_renderer->recording() )
+	{
+		IECore::MurmurHash h;
+		h.append( transform );
+		m_renderer->record( "transform", m_name, h );
+	}
+}
+
+void NullObjectInterface::transform( const std::vector<Imath::M44f> &samples, const std::vector<float> &times )
+{
+	m_renderer->m_statistics.transforms++;
+	m_renderer->m_statistics.transformSamples += samples.size();
+	if( m_renderer->recording() )
+	{
+		IECore::MurmurHash h;
+		for( size_t i = 0; i < samples.size(); ++i )
+		{
+			h.append( samples[i] );
+			h.append( times[i] );
+		}
+		m_renderer->record( "transform", m_name, h );
+	}
+}
+
+bool NullObjectInterface::attributes( const IECoreScenePreview::Renderer::AttributesInterface *attributes )
+{
+	m_renderer->m_statistics.attributeEdits++;
+	m_renderer->record( "attributes", m_name, MurmurHash(), attributes );
+	return true;
+}
+
+} // namespace
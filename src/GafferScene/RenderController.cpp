@@ -36,7 +36,10 @@
 
 #include "GafferScene/RenderController.h"
 
+#include "GafferScene/Constraint.h"
+#include "GafferScene/MapProjection.h"
 #include "GafferScene/SceneAlgo.h"
+#include "GafferScene/SceneElementProcessor.h"
 
 #include "Gaffer/ParallelAlgo.h"
 
@@ -46,11 +49,17 @@
 
 #include "IECore/NullObject.h"
 
+#include "OpenEXR/ImathBoxAlgo.h"
+
 #include "boost/algorithm/string/predicate.hpp"
 #include "boost/bind.hpp"
 
+#include "tbb/spin_mutex.h"
 #include "tbb/task.h"
 
+#include <algorithm>
+#include <set>
+
 using namespace std;
 using namespace Imath;
 using namespace IECore;
@@ -94,6 +103,149 @@ bool cameraGlobalsChanged( const CompoundObject *globals, const CompoundObject *
 	return *camera1 != *camera2;
 }
 
+bool isOrIsDescendantOf( const Plug *plug, const Plug *ancestor )
+{
+	return plug == ancestor || ancestor->isAncestorOf( plug );
+}
+
+// Returns the paths which are in only one of `a` and `b`.
+PathMatcher symmetricDifference( const PathMatcher &a, const PathMatcher &b )
+{
+	PathMatcher result;
+	for( PathMatcher::Iterator it = a.begin(), eIt = a.end(); it != eIt; ++it )
+	{
+		if( !( b.match( *it ) & PathMatcher::ExactMatch ) )
+		{
+			result.addPath( *it );
+		}
+	}
+	for( PathMatcher::Iterator it = b.begin(), eIt = b.end(); it != eIt; ++it )
+	{
+		if( !( a.match( *it ) & PathMatcher::ExactMatch ) )
+		{
+			result.addPath( *it );
+		}
+	}
+	return result;
+}
+
+// Locations covering less than this fraction of the priority
+// camera's view are not considered important.
+const float g_importanceThreshold = 0.01f;
+
+// Measures the fraction of a camera's screen window covered by
+// bounding boxes specified in camera space.
+class ScreenCoverage
+{
+
+	public :
+
+		ScreenCoverage( const IECoreScene::Camera *camera )
+			:	m_perspective( camera->getProjection() == "perspective" ),
+				m_screenWindow( camera->hasResolution() ? camera->frustum() : camera->frustum( IECoreScene::Camera::Distort ) ),
+				m_clippingPlanes( camera->getClippingPlanes() )
+		{
+		}
+
+		float operator()( const Box3f &bound ) const
+		{
+			if( bound.isEmpty() || bound.min.z > -m_clippingPlanes[0] || bound.max.z < -m_clippingPlanes[1] )
+			{
+				return 0.0f;
+			}
+
+			Box2f projected;
+			if( m_perspective )
+			{
+				if( bound.max.z > -m_clippingPlanes[0] )
+				{
+					// Straddles the near clipping plane, and may
+					// well contain the camera. Assume that it fills
+					// the view.
+					return 1.0f;
+				}
+				for( int i = 0; i < 8; ++i )
+				{
+					const V3f p(
+						i & 1 ? bound.max.x : bound.min.x,
+						i & 2 ? bound.max.y : bound.min.y,
+						i & 4 ? bound.max.z : bound.min.z
+					);
+					projected.extendBy( V2f( p.x, p.y ) / -p.z );
+				}
+			}
+			else
+			{
+				projected = Box2f( V2f( bound.min.x, bound.min.y ), V2f( bound.max.x, bound.max.y ) );
+			}
+
+			const V2f covered(
+				std::min( projected.max.x, m_screenWindow.max.x ) - std::max( projected.min.x, m_screenWindow.min.x ),
+				std::min( projected.max.y, m_screenWindow.max.y ) - std::max( projected.min.y, m_screenWindow.min.y )
+			);
+			if( covered.x <= 0.0f || covered.y <= 0.0f )
+			{
+				return 0.0f;
+			}
+
+			const V2f size = m_screenWindow.size();
+			return ( covered.x * covered.y ) / ( size.x * size.y );
+		}
+
+	private :
+
+		bool m_perspective;
+		Box2f m_screenWindow;
+		V2f m_clippingPlanes;
+
+};
+
+// Used with `SceneAlgo::parallelProcessLocations()` to find the locations
+// covering a significant fraction of a camera's view. Since a location's
+// bound contains the bounds of all its descendants, we can prune the
+// traversal as soon as a location falls below the threshold.
+struct ImportantPathsFunctor
+{
+
+	ImportantPathsFunctor( const ScreenCoverage &coverage, const M44f &worldToCamera, const PathMatcher &expandedPaths, size_t minimumExpansionDepth, PathMatcher &importantPaths, tbb::spin_mutex &mutex )
+		:	m_coverage( &coverage ), m_toCamera( worldToCamera ), m_expandedPaths( &expandedPaths ), m_minimumExpansionDepth( minimumExpansionDepth ),
+			m_importantPaths( &importantPaths ), m_mutex( &mutex )
+	{
+	}
+
+	bool operator()( const ScenePlug *scene, const ScenePlug::ScenePath &path )
+	{
+		m_toCamera = scene->transformPlug()->getValue() * m_toCamera;
+		const Box3f bound = Imath::transform( scene->boundPlug()->getValue(), m_toCamera );
+		if( (*m_coverage)( bound ) < g_importanceThreshold )
+		{
+			return false;
+		}
+
+		{
+			tbb::spin_mutex::scoped_lock lock( *m_mutex );
+			m_importantPaths->addPath( path );
+		}
+
+		// Children of unexpanded locations are not rendered,
+		// so there is no need to visit them.
+		return
+			m_minimumExpansionDepth >= path.size() ||
+			( m_expandedPaths->match( path ) & PathMatcher::ExactMatch )
+		;
+	}
+
+	private :
+
+		const ScreenCoverage *m_coverage;
+		M44f m_toCamera;
+		const PathMatcher *m_expandedPaths;
+		size_t m_minimumExpansionDepth;
+		PathMatcher *m_importantPaths;
+		tbb::spin_mutex *m_mutex;
+
+};
+
 } // namespace
 
 //////////////////////////////////////////////////////////////////////////
@@ -140,13 +292,15 @@ class RenderController::SceneGraph
 			ObjectComponent = 8,
 			ChildNamesComponent = 16,
 			ExpansionComponent = 32,
-			AllComponents = BoundComponent | TransformComponent | AttributesComponent | ObjectComponent | ChildNamesComponent | ExpansionComponent,
+			RenderSetsComponent = 64,
+			AllComponents = BoundComponent | TransformComponent | AttributesComponent | ObjectComponent | ChildNamesComponent | ExpansionComponent | RenderSetsComponent,
 		};
 
 		// Constructs the root of the scene graph.
 		// Children are constructed using updateChildren().
 		SceneGraph()
-			:	m_parent( nullptr ), m_fullAttributes( new CompoundObject ), m_dirtyComponents( AllComponents ), m_changedComponents( NoComponent )
+			:	m_parent( nullptr ), m_fullAttributes( new CompoundObject ), m_dirtyComponents( AllComponents ), m_changedComponents( NoComponent ), m_dirtyDescendants( false ),
+				m_inheritedStateVersion( 0 ), m_parentInheritedStateVersion( 0 )
 		{
 			clear();
 		}
@@ -161,23 +315,83 @@ class RenderController::SceneGraph
 			return m_name;
 		}
 
+		// Dirties `components` for this location and all its
+		// descendants.
 		void dirty( unsigned components )
 		{
-			if( ( components & m_dirtyComponents ) == components )
+			m_dirtyComponents |= components;
+			for( const auto &c : m_children )
+			{
+				c->dirty( components );
+			}
+		}
+
+		// As above, but only for the locations matched by `paths`, where
+		// `path` is the path to this location. Descendants of the matched
+		// locations are not dirtied, because they will be updated anyway
+		// if the changes affect the state they inherit. Ancestors are flagged
+		// so that the SceneGraphUpdateTask knows to visit them, and have their
+		// bounds dirtied, since they may depend on the matched locations.
+		void dirty( const PathMatcher &paths, unsigned components, ScenePlug::ScenePath &path )
+		{
+			const unsigned match = paths.match( path );
+			if( match & PathMatcher::ExactMatch )
+			{
+				m_dirtyComponents |= components;
+			}
+
+			if( !( match & PathMatcher::DescendantMatch ) )
 			{
 				return;
 			}
-			m_dirtyComponents |= components;
+
+			m_dirtyComponents |= components & BoundComponent;
+			m_dirtyDescendants = true;
+
+			path.push_back( InternedString() );
 			for( const auto &c : m_children )
 			{
-				c->dirty( components );
+				path.back() = c->name();
+				c->dirty( paths, components, path );
 			}
+			path.pop_back();
+		}
+
+		// Returns true if this location or any of its
+		// descendants requires updating.
+		bool updateRequired() const
+		{
+			return m_dirtyComponents != NoComponent || m_dirtyDescendants;
+		}
+
+		// Returns true if the last update changed state
+		// which must be inherited by the children.
+		bool inheritedStateChanged() const
+		{
+			return m_changedComponents & ( AttributesComponent | TransformComponent );
 		}
 
 		// Called by SceneGraphUpdateTask to update this location. Returns true if
 		// anything changed.
 		bool update( const ScenePlug::ScenePath &path, unsigned changedGlobals, Type type, const RenderController *controller )
 		{
+			// We may be visited again before `allChildrenUpdated()` is called,
+			// for instance by the full pass that follows a prioritised
+			// update. If we've already applied all our own changes and
+			// those inherited from our parent (or the globals, at the root),
+			// then there is nothing to do, and we mustn't send our attributes
+			// and transform to the renderer again.
+
+			const bool parentChanged = m_parent ?
+				m_parentInheritedStateVersion != m_parent->m_inheritedStateVersion :
+				( changedGlobals & GlobalsGlobalComponent ) && m_appliedGlobals != controller->m_globals
+			;
+
+			if( m_dirtyComponents == NoComponent && !parentChanged )
+			{
+				return false;
+			}
+
 			const unsigned originalChangedComponents = m_changedComponents;
 
 			// Attributes
@@ -189,19 +403,19 @@ class RenderController::SceneGraph
 				{
 					if( updateAttributes( controller->m_globals.get() ) )
 					{
-						m_changedComponents |= AttributesComponent;
+						changeInheritedState( AttributesComponent );
 					}
 				}
 			}
 			else
 			{
 				// Non-root - get attributes the standard way.
-				const bool parentAttributesChanged = m_parent->m_changedComponents & AttributesComponent;
+				const bool parentAttributesChanged = parentChanged && ( m_parent->m_changedComponents & AttributesComponent );
 				if( parentAttributesChanged || ( m_dirtyComponents & AttributesComponent ) )
 				{
 					if( updateAttributes( controller->m_scene->attributesPlug(), parentAttributesChanged ) )
 					{
-						m_changedComponents |= AttributesComponent;
+						changeInheritedState( AttributesComponent );
 					}
 				}
 			}
@@ -209,32 +423,33 @@ class RenderController::SceneGraph
 			if( !::visible( m_fullAttributes.get() ) )
 			{
 				clear();
+				inheritedStateApplied( controller );
 				return originalChangedComponents != m_changedComponents;
 			}
 
 			// Render Sets. We must obviously update these if
-			// the sets have changed, but we also need to do an
+			// our membership has changed, but we also need to do an
 			// update if the attributes have changed, because in
 			// that case we may have overwritten the sets attribute.
 
-			if( ( changedGlobals & RenderSetsGlobalComponent ) || ( m_changedComponents & AttributesComponent ) )
+			if( ( m_dirtyComponents & RenderSetsComponent ) || ( m_changedComponents & AttributesComponent ) )
 			{
 				if( updateRenderSets( path, controller->m_renderSets ) )
 				{
-					m_changedComponents |= AttributesComponent;
+					changeInheritedState( AttributesComponent );
 				}
 			}
 
-			clean( AttributesComponent );
+			clean( AttributesComponent | RenderSetsComponent );
 
 			// Transform
 
-			const bool parentTransformChanged = m_parent && ( m_parent->m_changedComponents & TransformComponent );
+			const bool parentTransformChanged = m_parent && parentChanged && ( m_parent->m_changedComponents & TransformComponent );
 			if( ( m_dirtyComponents & TransformComponent ) || parentTransformChanged )
 			{
 				if( updateTransform( controller->m_scene->transformPlug(), parentTransformChanged ) )
 				{
-					m_changedComponents |= TransformComponent;
+					changeInheritedState( TransformComponent );
 				}
 			}
 
@@ -335,9 +550,14 @@ class RenderController::SceneGraph
 			clean( ExpansionComponent | BoundComponent );
 
 			m_cleared = false;
+			// Our children must be visited before we're
+			// considered up to date.
+			m_dirtyDescendants = true;
 
 			assert( m_dirtyComponents == NoComponent );
 
+			inheritedStateApplied( controller );
+
 			return originalChangedComponents != m_changedComponents;
 		}
 
@@ -354,6 +574,7 @@ class RenderController::SceneGraph
 		void allChildrenUpdated()
 		{
 			m_changedComponents = NoComponent;
+			m_dirtyDescendants = false;
 		}
 
 		// Invalidates this location, removing any resources it
@@ -372,6 +593,7 @@ class RenderController::SceneGraph
 			m_expanded = false;
 			m_boundInterface = nullptr;
 			m_dirtyComponents = AllComponents;
+			m_dirtyDescendants = false;
 		}
 
 		// Returns true if the location has not been finalised
@@ -385,11 +607,33 @@ class RenderController::SceneGraph
 	private :
 
 		SceneGraph( const InternedString &name, const SceneGraph *parent )
-			:	m_name( name ), m_parent( parent ), m_fullAttributes( new CompoundObject )
+			:	m_name( name ), m_parent( parent ), m_fullAttributes( new CompoundObject ), m_changedComponents( NoComponent ), m_dirtyDescendants( false ),
+				m_inheritedStateVersion( 0 ), m_parentInheritedStateVersion( 0 )
 		{
 			clear();
 		}
 
+		// Records a change that must be inherited by our children.
+		void changeInheritedState( Component component )
+		{
+			m_changedComponents |= component;
+			m_inheritedStateVersion++;
+		}
+
+		// Called at the end of a successful `update()`, to record that
+		// we've applied the state inherited from our parent or the globals.
+		void inheritedStateApplied( const RenderController *controller )
+		{
+			if( m_parent )
+			{
+				m_parentInheritedStateVersion = m_parent->m_inheritedStateVersion;
+			}
+			else
+			{
+				m_appliedGlobals = controller->m_globals;
+			}
+		}
+
 		// Returns true if the attributes changed.
 		bool updateAttributes( const CompoundObjectPlug *attributesPlug, bool parentAttributesChanged )
 		{
@@ -691,6 +935,20 @@ class RenderController::SceneGraph
 		// We clear `m_changedComponents` once all children have
 		// been updated successfully, in `allChildrenUpdated()`.
 		unsigned m_changedComponents;
+		// True if descendants may need updating, either
+		// because they have been dirtied by `dirty( paths, components )`
+		// or because an update was interrupted before reaching
+		// them. Cleared in `allChildrenUpdated()`.
+		bool m_dirtyDescendants;
+		// Incremented each time we make a change that must be
+		// inherited by our children. Children record the version
+		// they last applied, so that they don't apply the same
+		// changes twice if they are visited again before
+		// `m_changedComponents` is cleared. The root records the
+		// globals it last applied instead.
+		size_t m_inheritedStateVersion;
+		size_t m_parentInheritedStateVersion;
+		IECore::ConstCompoundObjectPtr m_appliedGlobals;
 
 		bool m_cleared;
 
@@ -710,7 +968,8 @@ class RenderController::SceneGraphUpdateTask : public tbb::task
 			const ThreadState &threadState,
 			const ScenePlug::ScenePath &scenePath,
 			const ProgressCallback &callback,
-			const PathMatcher *pathsToUpdate
+			const PathMatcher *pathsToUpdate,
+			bool updateDescendants
 		)
 			:	m_controller( controller ),
 				m_sceneGraph( sceneGraph ),
@@ -719,7 +978,8 @@ class RenderController::SceneGraphUpdateTask : public tbb::task
 				m_threadState( threadState ),
 				m_scenePath( scenePath ),
 				m_callback( callback ),
-				m_pathsToUpdate( pathsToUpdate )
+				m_pathsToUpdate( pathsToUpdate ),
+				m_updateDescendants( updateDescendants )
 		{
 		}
 
@@ -732,6 +992,11 @@ class RenderController::SceneGraphUpdateTask : public tbb::task
 				return nullptr;
 			}
 
+			if( !m_updateDescendants && !( pathsToUpdateMatch & ( PathMatcher::ExactMatch | PathMatcher::DescendantMatch ) ) )
+			{
+				return nullptr;
+			}
+
 			// Figure out if this location belongs in the type
 			// of scene graph we're constructing. If it doesn't
 			// belong, and neither do any of its descendants,
@@ -763,23 +1028,43 @@ class RenderController::SceneGraphUpdateTask : public tbb::task
 				m_callback( BackgroundTask::Running );
 			}
 
-			// Spawn subtasks to apply updates to each child.
+			// Spawn subtasks to apply updates to each child. Children
+			// only need visiting if they have been dirtied, or if they
+			// need to inherit changes from this location. This allows
+			// us to skip the unaffected parts of the scene entirely.
 
 			const auto &children = m_sceneGraph->children();
 			if( m_sceneGraph->expanded() && children.size() )
 			{
-				set_ref_count( 1 + children.size() );
-
-				ScenePlug::ScenePath childPath = m_scenePath;
-				childPath.push_back( IECore::InternedString() ); // space for the child name
-				for( const auto &child : children )
+				const bool updateAllChildren = m_sceneGraph->inheritedStateChanged();
+				size_t numChildrenToUpdate = children.size();
+				if( !updateAllChildren )
 				{
-					childPath.back() = child->name();
-					SceneGraphUpdateTask *t = new( allocate_child() ) SceneGraphUpdateTask( m_controller, child.get(), m_sceneGraphType, m_changedGlobalComponents, m_threadState, childPath, m_callback, m_pathsToUpdate );
-					spawn( *t );
+					numChildrenToUpdate = count_if(
+						children.begin(), children.end(),
+						[]( const std::unique_ptr<SceneGraph> &c ) { return c->updateRequired(); }
+					);
 				}
 
-				wait_for_all();
+				if( numChildrenToUpdate )
+				{
+					set_ref_count( 1 + numChildrenToUpdate );
+
+					ScenePlug::ScenePath childPath = m_scenePath;
+					childPath.push_back( IECore::InternedString() ); // space for the child name
+					for( const auto &child : children )
+					{
+						if( !updateAllChildren && !child->updateRequired() )
+						{
+							continue;
+						}
+						childPath.back() = child->name();
+						SceneGraphUpdateTask *t = new( allocate_child() ) SceneGraphUpdateTask( m_controller, child.get(), m_sceneGraphType, m_changedGlobalComponents, m_threadState, childPath, m_callback, m_pathsToUpdate, m_updateDescendants );
+						spawn( *t );
+					}
+
+					wait_for_all();
+				}
 			}
 			else
 			{
@@ -789,7 +1074,7 @@ class RenderController::SceneGraphUpdateTask : public tbb::task
 				}
 			}
 
-			if( pathsToUpdateMatch & ( PathMatcher::AncestorMatch | PathMatcher::ExactMatch ) )
+			if( m_updateDescendants && ( pathsToUpdateMatch & ( PathMatcher::AncestorMatch | PathMatcher::ExactMatch ) ) )
 			{
 				m_sceneGraph->allChildrenUpdated();
 			}
@@ -841,6 +1126,228 @@ class RenderController::SceneGraphUpdateTask : public tbb::task
 		ScenePlug::ScenePath m_scenePath;
 		const ProgressCallback &m_callback;
 		const PathMatcher *m_pathsToUpdate;
+		bool m_updateDescendants;
+
+};
+
+// Used to limit updates to the locations affected by an edit, rather than
+// traversing the whole scene. We track the chain of SceneElementProcessors
+// immediately upstream of the scene. These never change the hierarchy, and
+// only modify the locations matched by their filter, so when the scene is
+// dirtied purely as a result of edits to their parameters, we know which
+// locations are affected. Any other source of dirtiness - from further
+// upstream, from a filter, or from reconnections - means the hint is
+// unavailable, and the RenderController falls back to dirtying the whole
+// scene graph.
+class RenderController::AffectedPathsHint : public boost::signals::trackable
+{
+
+	public :
+
+		AffectedPathsHint( const ScenePlug *scene )
+			:	m_scene( scene ), m_base( nullptr ), m_batchUnhinted( false ), m_pendingComponents( SceneGraph::NoComponent )
+		{
+			validate();
+		}
+
+		~AffectedPathsHint()
+		{
+			disconnect();
+		}
+
+		// Rebuilds the chain of nodes we're tracking. Returns false if it
+		// had changed, in which case any pending hints are discarded, and
+		// the caller must fall back to a full update.
+		bool validate()
+		{
+			const Plug *base = nullptr;
+			Chain chain = this->chain( base );
+			if( chain == m_chain && base == m_base && m_connections.size() )
+			{
+				return true;
+			}
+
+			m_chain.swap( chain );
+			m_base = base;
+			connect();
+
+			m_pendingNodes.clear();
+			m_pendingComponents = SceneGraph::NoComponent;
+			endBatch();
+			return false;
+		}
+
+		// Called when `components` of the scene are dirtied. Returns true if
+		// the dirtiness has been accounted for by the hint, and false if the
+		// caller must dirty the whole scene graph.
+		bool dirty( unsigned components )
+		{
+			if( m_batchUnhinted || m_batchNodes.empty() )
+			{
+				return false;
+			}
+
+			m_pendingNodes.insert( m_batchNodes.begin(), m_batchNodes.end() );
+			m_pendingComponents |= components;
+			return true;
+		}
+
+		// Called once dirtiness has been signalled for the
+		// whole scene. Subsequent signals belong to a new edit.
+		void endBatch()
+		{
+			m_batchNodes.clear();
+			m_batchUnhinted = false;
+		}
+
+		// Dirties the locations affected by all hints received since
+		// the last call. Must be called with an appropriate context.
+		void apply( RenderController *controller )
+		{
+			if( m_pendingNodes.empty() )
+			{
+				return;
+			}
+
+			PathMatcher paths;
+			for( const auto &node : m_pendingNodes )
+			{
+				SceneAlgo::matchingPaths( node->filterPlug(), node->inPlug(), paths );
+			}
+
+			controller->dirtySceneGraphs( paths, m_pendingComponents );
+			m_pendingNodes.clear();
+			m_pendingComponents = SceneGraph::NoComponent;
+		}
+
+	private :
+
+		typedef std::vector<ConstSceneElementProcessorPtr> Chain;
+
+		// Constraints and MapProjections read from locations other than
+		// those they modify, so upstream edits may affect locations outside
+		// their filter. We treat them as the end of the chain.
+		static bool localisesChanges( const SceneElementProcessor *node )
+		{
+			return !runTimeCast<const Constraint>( node ) && !runTimeCast<const MapProjection>( node );
+		}
+
+		Chain chain( const Plug *&base ) const
+		{
+			Chain result;
+			const Plug *plug = m_scene->source();
+			while( true )
+			{
+				const SceneElementProcessor *node = runTimeCast<const SceneElementProcessor>( plug->node() );
+				if( !node || plug != node->outPlug() || !localisesChanges( node ) )
+				{
+					break;
+				}
+				result.push_back( node );
+				plug = node->inPlug()->source();
+			}
+
+			base = plug;
+			return result;
+		}
+
+		void connect()
+		{
+			disconnect();
+
+			Node *sceneNode = const_cast<Node *>( m_scene->node() );
+			m_connections.push_back(
+				sceneNode->plugInputChangedSignal().connect( boost::bind( &AffectedPathsHint::plugInputChanged, this, ::_1, m_scene ) )
+			);
+
+			for( const auto &node : m_chain )
+			{
+				Node *n = const_cast<SceneElementProcessor *>( node.get() );
+				m_connections.push_back(
+					n->plugDirtiedSignal().connect( boost::bind( &AffectedPathsHint::chainPlugDirtied, this, ::_1, node.get() ) )
+				);
+				m_connections.push_back(
+					n->plugInputChangedSignal().connect( boost::bind( &AffectedPathsHint::plugInputChanged, this, ::_1, node->inPlug() ) )
+				);
+			}
+
+			// If the base belongs to a node in the chain, it is an unconnected
+			// input, and can only be changed by connecting it. We already track
+			// that via `plugInputChanged()`.
+			Node *baseNode = const_cast<Node *>( m_base->node() );
+			if( baseNode && ( m_chain.empty() || baseNode != m_chain.back().get() ) )
+			{
+				m_connections.push_back(
+					baseNode->plugDirtiedSignal().connect( boost::bind( &AffectedPathsHint::basePlugDirtied, this, ::_1 ) )
+				);
+			}
+		}
+
+		void disconnect()
+		{
+			for( auto &c : m_connections )
+			{
+				c.disconnect();
+			}
+			m_connections.clear();
+		}
+
+		void chainPlugDirtied( const Plug *plug, const SceneElementProcessor *node )
+		{
+			if(
+				plug->direction() == Plug::Out ||
+				isOrIsDescendantOf( plug, node->inPlug() )
+			)
+			{
+				// Dirtiness from upstream, which we account for
+				// via the upstream nodes, or consequences of
+				// dirtiness we have already seen.
+				return;
+			}
+
+			if( isOrIsDescendantOf( plug, node->filterPlug() ) || !node->filterPlug()->getInput() )
+			{
+				// We don't know which locations were matched
+				// before, or the filter matches everything.
+				m_batchUnhinted = true;
+				return;
+			}
+
+			if( std::find( m_batchNodes.begin(), m_batchNodes.end(), node ) == m_batchNodes.end() )
+			{
+				m_batchNodes.push_back( node );
+			}
+		}
+
+		void basePlugDirtied( const Plug *plug )
+		{
+			if( isOrIsDescendantOf( plug, m_base ) )
+			{
+				m_batchUnhinted = true;
+			}
+		}
+
+		void plugInputChanged( const Plug *plug, const Plug *trackedPlug )
+		{
+			if( isOrIsDescendantOf( plug, trackedPlug ) )
+			{
+				m_batchUnhinted = true;
+			}
+		}
+
+		const ScenePlug *m_scene;
+
+		Chain m_chain;
+		const Plug *m_base;
+		std::vector<boost::signals::connection> m_connections;
+
+		// State for the edit currently being signalled.
+		std::vector<const SceneElementProcessor *> m_batchNodes;
+		bool m_batchUnhinted;
+
+		// Accumulated from all edits since the last `apply()`.
+		std::set<ConstSceneElementProcessorPtr> m_pendingNodes;
+		unsigned m_pendingComponents;
 
 };
 
@@ -854,6 +1361,7 @@ RenderController::RenderController( const ConstScenePlugPtr &scene, const Gaffer
 		m_updateRequired( false ),
 		m_updateRequested( false ),
 		m_dirtyGlobalComponents( NoGlobalComponent ),
+		m_dirtySceneGraphComponents( SceneGraph::NoComponent ),
 		m_globals( new CompoundObject )
 {
 	for( int i = SceneGraph::FirstType; i <= SceneGraph::LastType; ++i )
@@ -908,6 +1416,7 @@ void RenderController::setScene( const ConstScenePlugPtr &scene )
 	m_plugDirtiedConnection = const_cast<Node *>( node )->plugDirtiedSignal().connect(
 		boost::bind( &RenderController::plugDirtied, this, ::_1 )
 	);
+	m_affectedPathsHint.reset( new AffectedPathsHint( m_scene.get() ) );
 
 	dirtyGlobals( AllGlobalComponents );
 	dirtySceneGraphs( SceneGraph::AllComponents );
@@ -947,8 +1456,15 @@ void RenderController::setExpandedPaths( const IECore::PathMatcher &expandedPath
 {
 	cancelBackgroundTask();
 
+	// Only the locations whose expansion has changed need updating.
+	const PathMatcher changed = symmetricDifference( m_expandedPaths, expandedPaths );
 	m_expandedPaths = expandedPaths;
-	dirtySceneGraphs( SceneGraph::ExpansionComponent );
+	if( changed.isEmpty() )
+	{
+		return;
+	}
+
+	dirtySceneGraphs( changed, SceneGraph::ExpansionComponent );
 	requestUpdate();
 }
 
@@ -976,6 +1492,24 @@ size_t RenderController::getMinimumExpansionDepth() const
 	return m_minimumExpansionDepth;
 }
 
+void RenderController::setPriorityCamera( const IECoreScene::Camera *camera, const Imath::M44f &transform )
+{
+	cancelBackgroundTask();
+
+	m_priorityCamera = camera ? camera->copy() : CameraPtr();
+	m_priorityCameraTransform = transform;
+}
+
+const IECoreScene::Camera *RenderController::getPriorityCamera() const
+{
+	return m_priorityCamera.get();
+}
+
+const Imath::M44f &RenderController::getPriorityCameraTransform() const
+{
+	return m_priorityCameraTransform;
+}
+
 RenderController::UpdateRequiredSignal &RenderController::updateRequiredSignal()
 {
 	return m_updateRequiredSignal;
@@ -988,25 +1522,26 @@ bool RenderController::updateRequired() const
 
 void RenderController::plugDirtied( const Gaffer::Plug *plug )
 {
+	unsigned components = SceneGraph::NoComponent;
 	if( plug == m_scene->boundPlug() )
 	{
-		dirtySceneGraphs( SceneGraph::BoundComponent );
+		components = SceneGraph::BoundComponent;
 	}
 	else if( plug == m_scene->transformPlug() )
 	{
-		dirtySceneGraphs( SceneGraph::TransformComponent );
+		components = SceneGraph::TransformComponent;
 	}
 	else if( plug == m_scene->attributesPlug() )
 	{
-		dirtySceneGraphs( SceneGraph::AttributesComponent );
+		components = SceneGraph::AttributesComponent;
 	}
 	else if( plug == m_scene->objectPlug() )
 	{
-		dirtySceneGraphs( SceneGraph::ObjectComponent );
+		components = SceneGraph::ObjectComponent;
 	}
 	else if( plug == m_scene->childNamesPlug() )
 	{
-		dirtySceneGraphs( SceneGraph::ChildNamesComponent );
+		components = SceneGraph::ChildNamesComponent;
 	}
 	else if( plug == m_scene->globalsPlug() )
 	{
@@ -1018,8 +1553,14 @@ void RenderController::plugDirtied( const Gaffer::Plug *plug )
 	}
 	else if( plug == m_scene )
 	{
+		m_affectedPathsHint->endBatch();
 		requestUpdate();
 	}
+
+	if( components != SceneGraph::NoComponent && !m_affectedPathsHint->dirty( components ) )
+	{
+		dirtySceneGraphs( components );
+	}
 }
 
 void RenderController::contextChanged( const IECore::InternedString &name )
@@ -1053,9 +1594,28 @@ void RenderController::dirtyGlobals( unsigned components )
 
 void RenderController::dirtySceneGraphs( unsigned components )
 {
+	// We defer the actual work until the next update, since
+	// we typically receive several calls in succession, and
+	// each requires a traversal of the entire scene graph.
+	m_dirtySceneGraphComponents |= components;
+}
+
+void RenderController::dirtySceneGraphs( const IECore::PathMatcher &paths, unsigned components )
+{
+	ScenePlug::ScenePath path;
 	for( auto &sg : m_sceneGraphs )
 	{
-		sg->dirty( components );
+		sg->dirty( paths, components, path );
+	}
+}
+
+void RenderController::prepareUpdate()
+{
+	if( !m_affectedPathsHint->validate() )
+	{
+		// Upstream nodes have been rewired in a way that
+		// we may not have been told about. Play it safe.
+		dirtySceneGraphs( SceneGraph::AllComponents );
 	}
 }
 
@@ -1067,6 +1627,7 @@ void RenderController::update( const ProgressCallback &callback )
 	}
 
 	m_updateRequested = false;
+	prepareUpdate();
 
 	Context::EditableScope scopedContext( m_context.get() );
 	scopedContext.set( "scene:renderer", m_renderer->name().string() );
@@ -1083,6 +1644,17 @@ std::shared_ptr<Gaffer::BackgroundTask> RenderController::updateInBackground( co
 
 	m_updateRequested = false;
 	cancelBackgroundTask();
+	prepareUpdate();
+
+	// Prioritising by screen coverage requires an additional traversal,
+	// which is only worthwhile when the whole scene needs updating.
+	// Targeted edits are already quick.
+	ConstCameraPtr priorityCamera;
+	if( m_dirtySceneGraphComponents != SceneGraph::NoComponent )
+	{
+		priorityCamera = m_priorityCamera;
+	}
+	const M44f priorityCameraTransform = m_priorityCameraTransform;
 
 	Context::EditableScope scopedContext( m_context.get() );
 	scopedContext.set( "scene:renderer", m_renderer->name().string() );
@@ -1090,11 +1662,16 @@ std::shared_ptr<Gaffer::BackgroundTask> RenderController::updateInBackground( co
 	m_backgroundTask = ParallelAlgo::callOnBackgroundThread(
 		// Subject
 		m_scene.get(),
-		[this, callback, priorityPaths] {
+		[this, callback, priorityPaths, priorityCamera, priorityCameraTransform] {
 			if( !priorityPaths.isEmpty() )
 			{
 				updateInternal( callback, &priorityPaths );
 			}
+			if( priorityCamera )
+			{
+				const PathMatcher paths = importantPaths( priorityCamera.get(), priorityCameraTransform );
+				updateInternal( callback, &paths, /* importantPathsOnly = */ true );
+			}
 			updateInternal( callback );
 		}
 	);
@@ -1109,13 +1686,15 @@ void RenderController::updateMatchingPaths( const IECore::PathMatcher &pathsToUp
 		return;
 	}
 
+	prepareUpdate();
+
 	Context::EditableScope scopedContext( m_context.get() );
 	scopedContext.set( "scene:renderer", m_renderer->name().string() );
 
 	updateInternal( callback, &pathsToUpdate );
 }
 
-void RenderController::updateInternal( const ProgressCallback &callback, const IECore::PathMatcher *pathsToUpdate )
+void RenderController::updateInternal( const ProgressCallback &callback, const IECore::PathMatcher *pathsToUpdate, bool importantPathsOnly )
 {
 	try
 	{
@@ -1139,14 +1718,37 @@ void RenderController::updateInternal( const ProgressCallback &callback, const I
 
 		if( m_dirtyGlobalComponents & SetsGlobalComponent )
 		{
-			if( m_renderSets.update( m_scene.get() ) & RendererAlgo::RenderSets::RenderSetsChanged )
+			PathMatcher changedPaths;
+			const unsigned changedSets = m_renderSets.update( m_scene.get(), &changedPaths );
+			if( changedSets & RendererAlgo::RenderSets::RenderSetsChanged )
+			{
+				// Only locations whose membership has changed need
+				// their sets attribute updating.
+				dirtySceneGraphs( changedPaths, SceneGraph::RenderSetsComponent );
+			}
+			if( changedSets & ( RendererAlgo::RenderSets::CamerasSetChanged | RendererAlgo::RenderSets::LightsSetChanged | RendererAlgo::RenderSets::LightFiltersSetChanged ) )
 			{
-				m_changedGlobalComponents |= RenderSetsGlobalComponent;
+				// These determine which scene graph each location belongs
+				// to, so we must visit every location.
+				dirtySceneGraphs( SceneGraph::ObjectComponent );
 			}
 		}
 
 		m_dirtyGlobalComponents = NoGlobalComponent;
 
+		// Apply pending dirtiness to the scene graphs
+
+		m_affectedPathsHint->apply( this );
+
+		if( m_dirtySceneGraphComponents != SceneGraph::NoComponent )
+		{
+			for( auto &sg : m_sceneGraphs )
+			{
+				sg->dirty( m_dirtySceneGraphComponents );
+			}
+			m_dirtySceneGraphComponents = SceneGraph::NoComponent;
+		}
+
 		// Update scene graphs
 
 		for( int i = SceneGraph::FirstType; i <= SceneGraph::LastType; ++i )
@@ -1160,9 +1762,15 @@ void RenderController::updateInternal( const ProgressCallback &callback, const I
 				sceneGraph->clear();
 			}
 
+			// Cameras and lights affect the appearance of everything
+			// else, so are always updated in full.
+			const bool prioritiseObjects = importantPathsOnly && i == SceneGraph::ObjectType;
+
 			tbb::task_group_context taskGroupContext( tbb::task_group_context::isolated );
 			SceneGraphUpdateTask *task = new( tbb::task::allocate_root( taskGroupContext ) ) SceneGraphUpdateTask(
-				this, sceneGraph, (SceneGraph::Type)i, m_changedGlobalComponents, ThreadState::current(), ScenePlug::ScenePath(), callback, pathsToUpdate
+				this, sceneGraph, (SceneGraph::Type)i, m_changedGlobalComponents, ThreadState::current(), ScenePlug::ScenePath(), callback,
+				importantPathsOnly && !prioritiseObjects ? nullptr : pathsToUpdate,
+				!prioritiseObjects
 			);
 			tbb::task::spawn_root_and_wait( *task );
 		}
@@ -1206,6 +1814,16 @@ void RenderController::updateInternal( const ProgressCallback &callback, const I
 	}
 }
 
+PathMatcher RenderController::importantPaths( const IECoreScene::Camera *camera, const Imath::M44f &cameraTransform ) const
+{
+	PathMatcher result;
+	tbb::spin_mutex mutex;
+	const ScreenCoverage coverage( camera );
+	ImportantPathsFunctor functor( coverage, cameraTransform.inverse(), m_expandedPaths, m_minimumExpansionDepth, result, mutex );
+	SceneAlgo::parallelProcessLocations( m_scene.get(), functor );
+	return result;
+}
+
 void RenderController::updateDefaultCamera()
 {
 	if( m_renderer->name() == g_openGLRendererName )
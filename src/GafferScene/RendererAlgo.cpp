@@ -60,6 +60,7 @@
 #include "boost/filesystem.hpp"
 
 #include "tbb/blocked_range.h"
+#include "tbb/parallel_for.h"
 #include "tbb/parallel_reduce.h"
 #include "tbb/task.h"
 
@@ -85,6 +86,78 @@ void motionTimes( size_t segments, const V2f &shutter, std::set<float> &times )
 	}
 }
 
+// Calls `f( i )` for each of `times` in parallel, with the frame of the current
+// context set to `times[i]`. Motion samples are typically few in number but
+// individually expensive, so we use a grain size of one.
+template<typename F>
+void parallelForEachSample( const std::vector<float> &times, F &&f )
+{
+	const ThreadState &threadState = ThreadState::current();
+
+	tbb::task_group_context taskGroupContext( tbb::task_group_context::isolated );
+	tbb::parallel_for(
+
+		tbb::blocked_range<size_t>( 0, times.size(), 1 ),
+
+		[&threadState, &times, &f]( const tbb::blocked_range<size_t> &r ) {
+
+			Context::EditableScope timeContext( threadState );
+			for( size_t i = r.begin(); i != r.end(); ++i )
+			{
+				timeContext.setFrame( times[i] );
+				f( i );
+			}
+
+		},
+
+		taskGroupContext // Prevents outer tasks silently cancelling our tasks
+
+	);
+}
+
+// Fills `hashes` with the hash of `plug` at each of `times`, and returns true
+// if they are not all identical.
+bool sampleHashes( const ValuePlug *plug, const std::vector<float> &times, std::vector<MurmurHash> &hashes )
+{
+	hashes.resize( times.size() );
+	parallelForEachSample(
+		times,
+		[plug, &hashes]( size_t i ) {
+			hashes[i] = plug->hash();
+		}
+	);
+
+	return std::find_if(
+		hashes.begin() + 1, hashes.end(),
+		[&hashes]( const MurmurHash &h ) { return h != hashes.front(); }
+	) != hashes.end();
+}
+
+// Returns the index of the first sample sharing the hash of each sample,
+// and fills `uniqueIndices` with the indices of the distinct samples, so
+// that identical samples need only be computed once.
+std::vector<size_t> uniqueSamples( const std::vector<MurmurHash> &hashes, std::vector<size_t> &uniqueIndices )
+{
+	std::vector<size_t> sources( hashes.size() );
+	for( size_t i = 0; i < hashes.size(); ++i )
+	{
+		sources[i] = i;
+		for( size_t j = 0; j < i; ++j )
+		{
+			if( hashes[j] == hashes[i] )
+			{
+				sources[i] = sources[j];
+				break;
+			}
+		}
+		if( sources[i] == i )
+		{
+			uniqueIndices.push_back( i );
+		}
+	}
+	return sources;
+}
+
 } // namespace
 
 //////////////////////////////////////////////////////////////////////////
@@ -124,25 +197,48 @@ void transformSamples( const ScenePlug *scene, size_t segments, const Imath::V2f
 		return;
 	}
 
-	// Motion case
+	// Motion case. We hash all the samples first, so that
+	// we only compute samples which are actually distinct.
 
 	motionTimes( segments, shutter, sampleTimes );
+	const vector<float> times( sampleTimes.begin(), sampleTimes.end() );
+
+	vector<MurmurHash> hashes;
+	if( !sampleHashes( scene->transformPlug(), times, hashes ) )
+	{
+		Context::EditableScope timeContext( Context::current() );
+		timeContext.setFrame( times.front() );
+		samples.push_back( scene->transformPlug()->getValue( &hashes.front() ) );
+		sampleTimes.clear();
+		return;
+	}
 
-	Context::EditableScope timeContext( Context::current() );
+	vector<size_t> uniqueIndices;
+	const vector<size_t> sources = uniqueSamples( hashes, uniqueIndices );
 
-	bool moving = false;
-	samples.reserve( sampleTimes.size() );
-	for( std::set<float>::const_iterator it = sampleTimes.begin(), eIt = sampleTimes.end(); it != eIt; ++it )
+	vector<float> uniqueTimes;
+	for( auto i : uniqueIndices )
 	{
-		timeContext.setFrame( *it );
-		const M44f m = scene->transformPlug()->getValue();
-		if( !moving && !samples.empty() && m != samples.front() )
-		{
-			moving = true;
+		uniqueTimes.push_back( times[i] );
+	}
+
+	samples.resize( times.size() );
+	parallelForEachSample(
+		uniqueTimes,
+		[scene, &samples, &hashes, &uniqueIndices]( size_t i ) {
+			const size_t sampleIndex = uniqueIndices[i];
+			samples[sampleIndex] = scene->transformPlug()->getValue( &hashes[sampleIndex] );
 		}
-		samples.push_back( m );
+	);
+
+	bool moving = false;
+	for( size_t i = 1; i < samples.size(); ++i )
+	{
+		samples[i] = samples[sources[i]];
+		moving = moving || samples[i] != samples.front();
 	}
 
+	// Distinct hashes don't guarantee distinct values.
 	if( !moving )
 	{
 		samples.resize( 1 );
@@ -165,52 +261,78 @@ void objectSamples( const ScenePlug *scene, size_t segments, const Imath::V2f &s
 		return;
 	}
 
-	// Motion case
+	// Motion case. The first sample is computed up front, as it tells
+	// us whether or not we need any more. We're done if the object is
+	// not deforming - which is common for rigid motion, where only
+	// the transform is animated - or if it is a type that can't be
+	// motion blurred anyway.
 
 	motionTimes( segments, shutter, sampleTimes );
+	const vector<float> times( sampleTimes.begin(), sampleTimes.end() );
 
-	Context::EditableScope timeContext( Context::current() );
+	vector<MurmurHash> hashes;
+	const bool moving = sampleHashes( scene->objectPlug(), times, hashes );
 
-	bool moving = false;
-	MurmurHash lastHash;
-	samples.reserve( sampleTimes.size() );
-	for( std::set<float>::const_iterator it = sampleTimes.begin(), eIt = sampleTimes.end(); it != eIt; ++it )
+	ConstObjectPtr firstSample;
 	{
-		timeContext.setFrame( *it );
+		Context::EditableScope timeContext( Context::current() );
+		timeContext.setFrame( times.front() );
+		firstSample = scene->objectPlug()->getValue( &hashes.front() );
+	}
 
-		const MurmurHash objectHash = scene->objectPlug()->hash();
-		ConstObjectPtr object = scene->objectPlug()->getValue( &objectHash );
+	const VisibleRenderable *renderable = runTimeCast<const VisibleRenderable>( firstSample.get() );
+	if( !renderable )
+	{
+		// We don't even know what these chappies are, so
+		// don't take any samples at all.
+		sampleTimes.clear();
+		return;
+	}
 
-		if( const Primitive *primitive = runTimeCast<const Primitive>( object.get() ) )
-		{
-			// We can support multiple samples for these, so check to see
-			// if we actually have something moving.
-			if( !moving && !samples.empty() && objectHash != lastHash )
-			{
-				moving = true;
-			}
-			samples.push_back( primitive );
-			lastHash = objectHash;
+	if( !moving || !runTimeCast<const Primitive>( renderable ) )
+	{
+		// Either a static primitive, or something we can't motion
+		// blur anyway, so just take the one sample.
+		samples.push_back( renderable );
+		sampleTimes.clear();
+		return;
+	}
+
+	// Compute the remaining distinct samples in parallel.
+
+	vector<size_t> uniqueIndices;
+	const vector<size_t> sources = uniqueSamples( hashes, uniqueIndices );
+
+	vector<float> uniqueTimes;
+	for( size_t i = 1; i < uniqueIndices.size(); ++i )
+	{
+		uniqueTimes.push_back( times[uniqueIndices[i]] );
+	}
+
+	vector<ConstObjectPtr> objects( times.size() );
+	objects.front() = firstSample;
+	parallelForEachSample(
+		uniqueTimes,
+		[scene, &objects, &hashes, &uniqueIndices]( size_t i ) {
+			const size_t sampleIndex = uniqueIndices[i + 1];
+			objects[sampleIndex] = scene->objectPlug()->getValue( &hashes[sampleIndex] );
 		}
-		else if( const VisibleRenderable *renderable = runTimeCast< const VisibleRenderable >( object.get() ) )
+	);
+
+	samples.reserve( times.size() );
+	for( size_t i = 0; i < times.size(); ++i )
+	{
+		const Primitive *primitive = runTimeCast<const Primitive>( objects[sources[i]].get() );
+		if( !primitive )
 		{
-			// We can't motion blur these chappies, so just take the one
-			// sample.
+			// Type changed during the shutter. We can't interpolate
+			// that, so fall back to the first sample.
+			samples.clear();
 			samples.push_back( renderable );
-			break;
-		}
-		else
-		{
-			// We don't even know what these chappies are, so
-			// don't take any samples at all.
-			break;
+			sampleTimes.clear();
+			return;
 		}
-	}
-
-	if( !moving )
-	{
-		samples.resize( std::min<size_t>( samples.size(), 1 ) );
-		sampleTimes.clear();
+		samples.push_back( primitive );
 	}
 }
 
@@ -299,13 +421,13 @@ namespace RendererAlgo
 struct RenderSets::Updater
 {
 
-	Updater( const ScenePlug *scene, const ThreadState &threadState, RenderSets &renderSets, unsigned changed )
-		:	changed( changed ), m_scene( scene ), m_threadState( threadState ), m_renderSets( renderSets )
+	Updater( const ScenePlug *scene, const ThreadState &threadState, RenderSets &renderSets, unsigned changed, bool trackChangedPaths )
+		:	changed( changed ), m_scene( scene ), m_threadState( threadState ), m_renderSets( renderSets ), m_trackChangedPaths( trackChangedPaths )
 	{
 	}
 
 	Updater( const Updater &updater, tbb::split )
-		:	changed( NothingChanged ), m_scene( updater.m_scene ), m_threadState( updater.m_threadState ), m_renderSets( updater.m_renderSets )
+		:	changed( NothingChanged ), m_scene( updater.m_scene ), m_threadState( updater.m_threadState ), m_renderSets( updater.m_renderSets ), m_trackChangedPaths( updater.m_trackChangedPaths )
 	{
 	}
 
@@ -349,7 +471,13 @@ struct RenderSets::Updater
 			const IECore::MurmurHash &hash = m_scene->setPlug()->hash();
 			if( s->hash != hash )
 			{
-				s->set = m_scene->setPlug()->getValue( &hash )->readable();
+				ConstPathMatcherDataPtr set = m_scene->setPlug()->getValue( &hash );
+				if( m_trackChangedPaths && potentialChange == RenderSetsChanged )
+				{
+					addChangedPaths( s->set, set->readable() );
+					addChangedPaths( set->readable(), s->set );
+				}
+				s->set = set->readable();
 				s->hash = hash;
 				changed |= potentialChange;
 			}
@@ -359,15 +487,30 @@ struct RenderSets::Updater
 	void join( Updater &rhs )
 	{
 		changed |= rhs.changed;
+		changedPaths.addPaths( rhs.changedPaths );
 	}
 
 	unsigned changed;
+	PathMatcher changedPaths;
 
 	private :
 
+		// Adds paths which are in `a` but not `b`.
+		void addChangedPaths( const PathMatcher &a, const PathMatcher &b )
+		{
+			for( PathMatcher::Iterator it = a.begin(), eIt = a.end(); it != eIt; ++it )
+			{
+				if( !( b.match( *it ) & PathMatcher::ExactMatch ) )
+				{
+					changedPaths.addPath( *it );
+				}
+			}
+		}
+
 		const ScenePlug *m_scene;
 		const ThreadState &m_threadState;
 		RenderSets &m_renderSets;
+		const bool m_trackChangedPaths;
 
 };
 
@@ -383,7 +526,7 @@ RenderSets::RenderSets( const ScenePlug *scene )
 	update( scene );
 }
 
-unsigned RenderSets::update( const ScenePlug *scene )
+unsigned RenderSets::update( const ScenePlug *scene, IECore::PathMatcher *changedPaths )
 {
 	unsigned changed = NothingChanged;
 
@@ -408,6 +551,10 @@ unsigned RenderSets::update( const ScenePlug *scene )
 	{
 		if( std::find( setNames.begin(), setNames.end(), it->first ) == setNames.end() )
 		{
+			if( changedPaths )
+			{
+				changedPaths->addPaths( it->second.set );
+			}
 			it = m_sets.erase( it );
 			changed |= RenderSetsChanged;
 		}
@@ -419,7 +566,7 @@ unsigned RenderSets::update( const ScenePlug *scene )
 
 	// Update all the sets we want in parallel.
 
-	Updater updater( scene, ThreadState::current(), *this, changed );
+	Updater updater( scene, ThreadState::current(), *this, changed, changedPaths );
 	tbb::task_group_context taskGroupContext( tbb::task_group_context::isolated );
 	parallel_reduce(
 		tbb::blocked_range<size_t>( 0, m_sets.size() + 3 ),
@@ -429,6 +576,11 @@ unsigned RenderSets::update( const ScenePlug *scene )
 		taskGroupContext
 	);
 
+	if( changedPaths )
+	{
+		changedPaths->addPaths( updater.changedPaths );
+	}
+
 	return updater.changed;
 }
 
@@ -44,6 +44,7 @@
 #include "Gaffer/Context.h"
 #include "Gaffer/Monitor.h"
 #include "Gaffer/Process.h"
+#include "Gaffer/Private/IECorePreview/PathMatcherAlgo.h"
 
 #include "IECoreScene/Camera.h"
 #include "IECoreScene/ClippingPlane.h"
@@ -114,17 +115,14 @@ namespace
 
 struct ThreadablePathAccumulator
 {
-	ThreadablePathAccumulator( PathMatcher &result): m_result( result ){}
 
 	bool operator()( const GafferScene::ScenePlug *scene, const GafferScene::ScenePlug::ScenePath &path )
 	{
-		tbb::spin_mutex::scoped_lock lock( m_mutex );
-		m_result.addPath( path );
+		m_accumulator.addPath( path );
 		return true;
 	}
 
-	tbb::spin_mutex m_mutex;
-	PathMatcher &m_result;
+	IECorePreview::PathMatcherAlgo::Accumulator m_accumulator;
 
 };
 
@@ -137,14 +135,16 @@ void GafferScene::SceneAlgo::matchingPaths( const Filter *filter, const ScenePlu
 
 void GafferScene::SceneAlgo::matchingPaths( const Gaffer::IntPlug *filterPlug, const ScenePlug *scene, PathMatcher &paths )
 {
-	ThreadablePathAccumulator f( paths );
+	ThreadablePathAccumulator f;
 	GafferScene::SceneAlgo::filteredParallelTraverse( scene, filterPlug, f );
+	paths.addPaths( f.m_accumulator.result() );
 }
 
 void GafferScene::SceneAlgo::matchingPaths( const PathMatcher &filter, const ScenePlug *scene, PathMatcher &paths )
 {
-	ThreadablePathAccumulator f( paths );
+	ThreadablePathAccumulator f;
 	GafferScene::SceneAlgo::filteredParallelTraverse( scene, filter, f );
+	paths.addPaths( f.m_accumulator.result() );
 }
 
 IECore::ConstCompoundObjectPtr GafferScene::SceneAlgo::globalAttributes( const IECore::CompoundObject *globals )
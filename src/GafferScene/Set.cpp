@@ -39,6 +39,7 @@
 #include "GafferScene/FilterResults.h"
 
 #include "Gaffer/StringPlug.h"
+#include "Gaffer/Private/IECorePreview/PathMatcherAlgo.h"
 
 #include "IECore/StringAlgo.h"
 
@@ -184,27 +185,27 @@ void Set::compute( Gaffer::ValuePlug *output, const Gaffer::Context *context ) c
 		ConstStringVectorDataPtr pathsData = pathsPlug()->getValue();
 		const vector<string> &paths = pathsData->readable();
 
-		PathMatcherDataPtr pathMatcherData = new PathMatcherData;
-		PathMatcher &pathMatcher = pathMatcherData->writable();
-
-		vector<InternedString> tokenizedPath;
-		for( vector<string>::const_iterator it = paths.begin(), eIt = paths.end(); it != eIt; ++it )
-		{
-			if( it->empty() )
-			{
-				continue;
-			}
-			tokenizedPath.clear();
-			StringAlgo::tokenize( *it, '/', tokenizedPath );
-			for( vector<InternedString>::const_iterator nIt = tokenizedPath.begin(), neIt = tokenizedPath.end(); nIt != neIt; ++nIt )
-			{
-				if( StringAlgo::hasWildcards( nIt->c_str() ) || *nIt == g_ellipsis )
-				{
-					throw IECore::Exception( "Path \"" + *it + "\" contains wildcards." );
+		PathMatcherDataPtr pathMatcherData = new PathMatcherData(
+			IECorePreview::PathMatcherAlgo::build(
+				paths.begin(), paths.end(),
+				[]( const string &path, vector<InternedString> &tokenizedPath ) {
+					if( path.empty() )
+					{
+						return false;
+					}
+					StringAlgo::tokenize( path, '/', tokenizedPath );
+					for( const auto &name : tokenizedPath )
+					{
+						if( StringAlgo::hasWildcards( name.c_str() ) || name == g_ellipsis )
+						{
+							throw IECore::Exception( "Path \"" + path + "\" contains wildcards." );
+						}
+					}
+					return true;
 				}
-			}
-			pathMatcher.addPath( tokenizedPath );
-		}
+			)
+		);
+		PathMatcher &pathMatcher = pathMatcherData->writable();
 
 		pathMatcher.addPaths( filterResultsPlug()->getValue()->readable() );
 
@@ -215,6 +216,17 @@ void Set::compute( Gaffer::ValuePlug *output, const Gaffer::Context *context ) c
 	FilteredSceneProcessor::compute( output, context );
 }
 
+Gaffer::ValuePlug::CachePolicy Set::computeCachePolicy( const Gaffer::ValuePlug *output ) const
+{
+	if( output == pathMatcherPlug() )
+	{
+		// Paths are tokenised in parallel, so we must allow other threads
+		// to collaborate rather than wait.
+		return ValuePlug::CachePolicy::TaskCollaboration;
+	}
+	return FilteredSceneProcessor::computeCachePolicy( output );
+}
+
 void Set::hashSetNames( const Gaffer::Context *context, const ScenePlug *parent, IECore::MurmurHash &h ) const
 {
 	FilteredSceneProcessor::hashSetNames( context, parent, h );
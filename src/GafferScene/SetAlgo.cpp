@@ -40,6 +40,7 @@
 
 #include "GafferScene/SetAlgo.h"
 
+#include "IECore/LRUCache.h"
 #include "IECore/MessageHandler.h"
 
 #include "boost/algorithm/string/predicate.hpp"
@@ -50,6 +51,8 @@
 #include "boost/variant/apply_visitor.hpp"
 #include "boost/variant/recursive_variant.hpp"
 
+#include <memory>
+
 using namespace IECore;
 using namespace Gaffer;
 using namespace GafferScene;
@@ -490,6 +493,29 @@ void expressionToAST( const std::string &setExpression, ExpressionAst &ast)
 	}
 }
 
+// Parsing is relatively expensive, not least because it requires the
+// construction of a grammar, and the same expressions are typically
+// hashed and evaluated many times. So we cache the ASTs for recently
+// used expressions. Syntax errors are cached too, and rethrown each
+// time the expression is used.
+typedef std::shared_ptr<const ExpressionAst> ConstExpressionAstPtr;
+
+ConstExpressionAstPtr astGetter( const std::string &setExpression, size_t &cost )
+{
+	std::shared_ptr<ExpressionAst> ast = std::make_shared<ExpressionAst>();
+	expressionToAST( setExpression, *ast );
+	cost = 1;
+	return ast;
+}
+
+typedef IECore::LRUCache<std::string, ConstExpressionAstPtr> AstCache;
+
+AstCache &astCache()
+{
+	static AstCache *c = new AstCache( astGetter, 1000 );
+	return *c;
+}
+
 } // namespace
 
 BOOST_FUSION_ADAPT_STRUCT(
@@ -510,20 +536,18 @@ namespace SetAlgo
 
 PathMatcher evaluateSetExpression( const std::string &setExpression, const ScenePlug *scene )
 {
-	ExpressionAst ast;
-	expressionToAST( setExpression, ast );
+	ConstExpressionAstPtr ast = astCache().get( setExpression );
 
 	AstEvaluator eval( scene );
-	return eval( ast );
+	return eval( *ast );
 }
 
 void setExpressionHash( const std::string &setExpression, const ScenePlug* scene, IECore::MurmurHash &h )
 {
-	ExpressionAst ast;
-	expressionToAST( setExpression, ast );
+	ConstExpressionAstPtr ast = astCache().get( setExpression );
 
 	AstHasher hasher = AstHasher( scene, h );
-	hasher(ast);
+	hasher( *ast );
 }
 
 IECore::MurmurHash setExpressionHash( const std::string &setExpression, const ScenePlug* scene)
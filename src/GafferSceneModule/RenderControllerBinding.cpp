@@ -44,7 +44,10 @@
 
 #include "Gaffer/Context.h"
 
+#include "IECorePython/ExceptionAlgo.h"
 #include "IECorePython/RefCountedBinding.h"
+#include "IECorePython/ScopedGILLock.h"
+#include "IECorePython/ScopedGILRelease.h"
 
 using namespace boost::python;
 
@@ -91,6 +94,21 @@ void setMinimumExpansionDepth( RenderController &r, size_t depth )
 	r.setMinimumExpansionDepth( depth );
 }
 
+void setPriorityCamera( RenderController &r, const IECoreScene::Camera *camera, const M44f &transform )
+{
+	IECorePython::ScopedGILRelease gilRelease;
+	r.setPriorityCamera( camera, transform );
+}
+
+IECoreScene::CameraPtr getPriorityCamera( RenderController &r )
+{
+	if( const IECoreScene::Camera *camera = r.getPriorityCamera() )
+	{
+		return camera->copy();
+	}
+	return nullptr;
+}
+
 void update( RenderController &r )
 {
 	IECorePython::ScopedGILRelease gilRelease;
@@ -103,6 +121,37 @@ void updateMatchingPaths( RenderController &r, const IECore::PathMatcher &pathsT
 	r.updateMatchingPaths( pathsToUpdate );
 }
 
+std::shared_ptr<BackgroundTask> updateInBackground( RenderController &r, object callback, const IECore::PathMatcher &priorityPaths )
+{
+	RenderController::ProgressCallback progressCallback;
+	if( callback )
+	{
+		// The callback will be owned by the BackgroundTask, so
+		// must acquire the GIL before the python object is destroyed.
+		auto callbackPtr = std::shared_ptr<object>(
+			new object( callback ),
+			[]( object *o ) {
+				IECorePython::ScopedGILLock gilLock;
+				delete o;
+			}
+		);
+		progressCallback = [callbackPtr]( BackgroundTask::Status status ) {
+			IECorePython::ScopedGILLock gilLock;
+			try
+			{
+				(*callbackPtr)( status );
+			}
+			catch( boost::python::error_already_set &e )
+			{
+				IECorePython::ExceptionAlgo::translatePythonException();
+			}
+		};
+	}
+
+	IECorePython::ScopedGILRelease gilRelease;
+	return r.updateInBackground( progressCallback, priorityPaths );
+}
+
 } // namespace
 
 void GafferSceneModule::bindRenderController()
@@ -119,9 +168,13 @@ void GafferSceneModule::bindRenderController()
 		.def( "getExpandedPaths", &RenderController::getExpandedPaths, return_value_policy<copy_const_reference>() )
 		.def( "setMinimumExpansionDepth", &setMinimumExpansionDepth )
 		.def( "getMinimumExpansionDepth", &RenderController::getMinimumExpansionDepth )
+		.def( "setPriorityCamera", &setPriorityCamera, ( arg( "camera" ), arg( "transform" ) = M44f() ) )
+		.def( "getPriorityCamera", &getPriorityCamera )
+		.def( "getPriorityCameraTransform", &RenderController::getPriorityCameraTransform, return_value_policy<copy_const_reference>() )
 		.def( "updateRequiredSignal", &RenderController::updateRequiredSignal, return_internal_reference<1>() )
 		.def( "update", &update )
 		.def( "updateMatchingPaths", &updateMatchingPaths )
+		.def( "updateInBackground", &updateInBackground, ( arg( "callback" ) = object(), arg( "priorityPaths" ) = IECore::PathMatcher() ) )
 	;
 
 	SignalClass<RenderController::UpdateRequiredSignal>( "UpdateRequiredSignal" );
@@ -41,7 +41,10 @@
 #include "GafferScene/RendererAlgo.h"
 #include "GafferScene/SceneProcessor.h"
 
+#include "IECoreScene/VisibleRenderable.h"
+
 #include "IECorePython/ScopedGILLock.h"
+#include "IECorePython/ScopedGILRelease.h"
 
 using namespace boost::python;
 using namespace GafferScene;
@@ -75,6 +78,45 @@ void registerAdaptorWrapper( const std::string &name, object adaptor )
 	RendererAlgo::registerAdaptor( name, AdaptorWrapper( adaptor ) );
 }
 
+template<typename T>
+list toList( const T &container )
+{
+	list result;
+	for( const auto &x : container )
+	{
+		result.append( x );
+	}
+	return result;
+}
+
+tuple transformSamplesWrapper( const ScenePlug &scene, size_t segments, const Imath::V2f &shutter )
+{
+	std::vector<Imath::M44f> samples;
+	std::set<float> sampleTimes;
+	{
+		IECorePython::ScopedGILRelease gilRelease;
+		RendererAlgo::transformSamples( &scene, segments, shutter, samples, sampleTimes );
+	}
+	return make_tuple( toList( samples ), toList( sampleTimes ) );
+}
+
+tuple objectSamplesWrapper( const ScenePlug &scene, size_t segments, const Imath::V2f &shutter )
+{
+	std::vector<IECoreScene::ConstVisibleRenderablePtr> samples;
+	std::set<float> sampleTimes;
+	{
+		IECorePython::ScopedGILRelease gilRelease;
+		RendererAlgo::objectSamples( &scene, segments, shutter, samples, sampleTimes );
+	}
+
+	list pythonSamples;
+	for( const auto &s : samples )
+	{
+		pythonSamples.append( s->copy() );
+	}
+	return make_tuple( pythonSamples, toList( sampleTimes ) );
+}
+
 } // namespace
 
 namespace GafferSceneModule
@@ -86,6 +128,8 @@ void bindRendererAlgo()
 	def( "registerAdaptor", &registerAdaptorWrapper );
 	def( "deregisterAdaptor", &RendererAlgo::deregisterAdaptor );
 	def( "createAdaptors", &RendererAlgo::createAdaptors );
+	def( "transformSamples", &transformSamplesWrapper );
+	def( "objectSamples", &objectSamplesWrapper );
 
 }
 
@@ -67,7 +67,10 @@ SceneGadget::SceneGadget()
 	openGLOptions->members().insert( {
 		Option( "gl:primitive:wireframeColor", new Color4fData( Color4f( 0.2f, 0.2f, 0.2f, 1.0f ) ) ),
 		Option( "gl:primitive:pointColor", new Color4fData( Color4f( 0.9f, 0.9f, 0.9f, 1.0f ) ) ),
-		Option( "gl:primitive:pointWidth", new FloatData( 2.0f ) )
+		Option( "gl:primitive:pointWidth", new FloatData( 2.0f ) ),
+		Option( "gl:culling", new BoolData( true ) ),
+		Option( "gl:lod:minimumScreenSize", new FloatData( 1.0f ) ),
+		Option( "gl:frameBudget", new FloatData( 0.05f ) )
 	} );
 	setOpenGLOptions( openGLOptions.get() );
 
@@ -503,6 +506,13 @@ void SceneGadget::updateRenderer()
 		}
 	}
 
+	// Update the locations which dominate the view first, so that
+	// the user sees a meaningful picture as quickly as possible.
+	if( const ViewportGadget *viewportGadget = ancestor<ViewportGadget>() )
+	{
+		m_controller.setPriorityCamera( viewportGadget->getCamera().get(), viewportGadget->getCameraTransform() );
+	}
+
 	m_updateErrored = false;
 	m_updateTask = m_controller.updateInBackground( progressCallback, m_priorityPaths );
 	stateChangedSignal()( this );
@@ -523,6 +533,21 @@ void SceneGadget::renderScene() const
 		return;
 	}
 	m_renderer->render();
+
+	// If the renderer ran out of time, it will have drawn some objects
+	// as bounding boxes. Schedule another render so that it can continue
+	// refining them.
+	DataPtr complete = m_renderer->command( "gl:queryRenderComplete" );
+	if( !static_cast<BoolData *>( complete.get() )->readable() && !m_renderRequestPending.exchange( true ) )
+	{
+		SceneGadgetPtr thisRef = const_cast<SceneGadget *>( this );
+		ParallelAlgo::callOnUIThread(
+			[thisRef] {
+				thisRef->m_renderRequestPending = false;
+				thisRef->requestRender();
+			}
+		);
+	}
 }
 
 void SceneGadget::visibilityChanged()
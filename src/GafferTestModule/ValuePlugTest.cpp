@@ -40,8 +40,12 @@
 
 #include "GafferTest/MultiplyNode.h"
 
+#include "Gaffer/Context.h"
+#include "Gaffer/NumericPlug.h"
 #include "Gaffer/ValuePlug.h"
 
+#include "IECorePython/ScopedGILRelease.h"
+
 #include "tbb/parallel_for.h"
 
 using namespace boost::python;
@@ -66,9 +70,31 @@ void testValuePlugContentionForOneItem()
 	);
 }
 
+// Gets the value of `plug` concurrently from many contexts, each
+// with `iterationVariable` set to a different value.
+template<typename PlugType>
+void parallelGetValue( const PlugType *plug, int iterations, const std::string &iterationVariable )
+{
+	IECorePython::ScopedGILRelease gilRelease;
+	const ThreadState &threadState = ThreadState::current();
+	tbb::parallel_for(
+		tbb::blocked_range<int>( 0, iterations ),
+		[&]( const tbb::blocked_range<int> &r ) {
+			Context::EditableScope scope( threadState );
+			for( int i = r.begin(); i < r.end(); ++i )
+			{
+				scope.set( iterationVariable, i );
+				plug->getValue();
+			}
+		}
+	);
+}
+
 } // namespace
 
 void GafferTestModule::bindValuePlugTest()
 {
 	def( "testValuePlugContentionForOneItem", &testValuePlugContentionForOneItem );
+	def( "parallelGetValue", &parallelGetValue<IntPlug> );
+	def( "parallelGetValue", &parallelGetValue<FloatPlug> );
 }
@@ -299,7 +299,7 @@ void Gadget::renderLayer( Layer layer, const Style *currentStyle ) const
 			{
 				continue;
 			}
-			if( c->hasLayer( layer ) )
+			if( c->hasLayer( layer ) && shouldRenderChild( c ) )
 			{
 				c->renderLayer( layer, currentStyle );
 			}
@@ -330,6 +330,11 @@ bool Gadget::hasLayer( Layer layer ) const
 	return true;
 }
 
+bool Gadget::shouldRenderChild( const Gadget *child ) const
+{
+	return true;
+}
+
 Imath::Box3f Gadget::bound() const
 {
 	Box3f result;
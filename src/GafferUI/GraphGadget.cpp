@@ -69,6 +69,11 @@ IECORE_POP_DEFAULT_VISIBILITY
 
 #include "boost/bind.hpp"
 #include "boost/bind/placeholders.hpp"
+#include "boost/noncopyable.hpp"
+
+#include <cmath>
+#include <unordered_map>
+#include <unordered_set>
 
 using namespace GafferUI;
 using namespace Imath;
@@ -104,6 +109,48 @@ const InternedString g_nodeGadgetTypeName( "nodeGadget:type" );
 const InternedString g_auxiliaryConnectionsGadgetName( "__auxiliaryConnections" );
 const InternedString g_annotationsGadgetName( "__annotations" );
 
+// Connection curves may bow slightly outside the bounds of their end points,
+// so we pad regions by this amount when culling and picking connections.
+const float g_connectionMargin = 5.0f;
+
+// Returns the region of the XY plane which may be visible through the
+// current GL projection, or an infinite box if this can't be determined.
+// When rendering for selection, the projection is narrowed to the region
+// being selected, so this also accelerates picking.
+Box2f visibleRegion()
+{
+	M44f modelView, projection;
+	glGetFloatv( GL_MODELVIEW_MATRIX, modelView.getValue() );
+	glGetFloatv( GL_PROJECTION_MATRIX, projection.getValue() );
+
+	M44f inverse;
+	try
+	{
+		inverse = ( modelView * projection ).inverse( /* singExc = */ true );
+	}
+	catch( const std::exception & )
+	{
+		return Box2f( V2f( -limits<float>::max() ), V2f( limits<float>::max() ) );
+	}
+
+	Box2f result;
+	for( int i = 0; i < 8; ++i )
+	{
+		const V3f ndc( i & 1 ? 1 : -1, i & 2 ? 1 : -1, i & 4 ? 1 : -1 );
+		V3f p;
+		inverse.multVecMatrix( ndc, p );
+		if( !std::isfinite( p.x ) || !std::isfinite( p.y ) )
+		{
+			return Box2f( V2f( -limits<float>::max() ), V2f( limits<float>::max() ) );
+		}
+		result.extendBy( V2f( p.x, p.y ) );
+	}
+
+	result.min -= V2f( g_connectionMargin );
+	result.max += V2f( g_connectionMargin );
+	return result;
+}
+
 struct CompareV2fX{
 	bool operator()(const Imath::V2f &a, const Imath::V2f &b) const
 	{
@@ -113,6 +160,332 @@ struct CompareV2fX{
 
 } // namespace
 
+//////////////////////////////////////////////////////////////////////////
+// SpatialIndex
+//////////////////////////////////////////////////////////////////////////
+
+// A quadtree storing the bounds of gadgets in GraphGadget space. Bounds are
+// updated lazily : gadgets are marked as dirty when they request a render, and
+// are reinserted into the tree the next time it is queried.
+class GraphGadget::SpatialIndex : public boost::noncopyable
+{
+
+	public :
+
+		SpatialIndex()
+			:	m_root( new Cell( Box2f( V2f( -g_initialSize ), V2f( g_initialSize ) ), nullptr ) ), m_visibilityEpoch( 0 ), m_cullingEnabled( false )
+		{
+		}
+
+		void add( Gadget *gadget )
+		{
+			EntryPtr &entry = m_entries[gadget];
+			if( entry )
+			{
+				return;
+			}
+
+			entry.reset( new Entry );
+			entry->gadget = gadget;
+			entry->cell = nullptr;
+			entry->visibilityEpoch = 0;
+			entry->renderRequestConnection = gadget->renderRequestSignal().connect(
+				boost::bind( &SpatialIndex::dirty, this, ::_1 )
+			);
+			m_dirty.insert( gadget );
+		}
+
+		void remove( const Gadget *gadget )
+		{
+			auto it = m_entries.find( gadget );
+			if( it == m_entries.end() )
+			{
+				return;
+			}
+			removeFromCell( it->second.get() );
+			m_entries.erase( it );
+			m_dirty.erase( gadget );
+		}
+
+		void dirty( const Gadget *gadget )
+		{
+			if( m_entries.find( gadget ) != m_entries.end() )
+			{
+				m_dirty.insert( gadget );
+			}
+		}
+
+		template<typename Predicate>
+		void query( const Box2f &region, Predicate &&predicate )
+		{
+			update();
+			for( const Entry *entry : m_unbounded )
+			{
+				if( entry->bound.intersects( region ) )
+				{
+					predicate( entry->gadget );
+				}
+			}
+			query( m_root.get(), region, predicate );
+		}
+
+		// Marks the gadgets intersecting `region` as visible, and all others
+		// as culled. An infinite region disables culling entirely.
+		void cull( const Box2f &region )
+		{
+			m_cullingEnabled = isFinite( region );
+			if( !m_cullingEnabled )
+			{
+				return;
+			}
+
+			m_visibilityEpoch++;
+			query(
+				region,
+				[this]( Gadget *gadget ) {
+					m_entries[gadget]->visibilityEpoch = m_visibilityEpoch;
+				}
+			);
+
+			// We don't know where unbounded gadgets will draw,
+			// so must always render them.
+			for( Entry *entry : m_unbounded )
+			{
+				entry->visibilityEpoch = m_visibilityEpoch;
+			}
+		}
+
+		// Returns true if the gadget was within the last region passed to
+		// cull(). Gadgets which are not indexed are always visible.
+		bool visible( const Gadget *gadget ) const
+		{
+			if( !m_cullingEnabled )
+			{
+				return true;
+			}
+			auto it = m_entries.find( gadget );
+			return it == m_entries.end() || it->second->visibilityEpoch == m_visibilityEpoch;
+		}
+
+	private :
+
+		static constexpr float g_initialSize = 1024.0f;
+		// Bounds beyond this are treated as unbounded, to avoid
+		// growing the tree indefinitely.
+		static constexpr float g_maxSize = 1e7f;
+		static constexpr int g_maxDepth = 16;
+
+		struct Cell;
+
+		struct Entry
+		{
+			Gadget *gadget;
+			Box2f bound;
+			// The cell containing this entry, or nullptr if
+			// it is stored in `m_unbounded`.
+			Cell *cell;
+			size_t visibilityEpoch;
+			boost::signals::scoped_connection renderRequestConnection;
+		};
+
+		typedef std::unique_ptr<Entry> EntryPtr;
+
+		struct Cell
+		{
+			Cell( const Box2f &b, Cell *p )
+				:	bound( b ), parent( p )
+			{
+			}
+
+			Box2f childBound( int quadrant ) const
+			{
+				const V2f c = bound.center();
+				return Box2f(
+					V2f( quadrant & 1 ? c.x : bound.min.x, quadrant & 2 ? c.y : bound.min.y ),
+					V2f( quadrant & 1 ? bound.max.x : c.x, quadrant & 2 ? bound.max.y : c.y )
+				);
+			}
+
+			bool empty() const
+			{
+				return entries.empty() && !children[0] && !children[1] && !children[2] && !children[3];
+			}
+
+			const Box2f bound;
+			Cell *parent;
+			std::vector<Entry *> entries;
+			std::unique_ptr<Cell> children[4];
+		};
+
+		static bool isFinite( const Box2f &b )
+		{
+			return
+				!b.isEmpty() &&
+				b.min.x > -g_maxSize && b.min.y > -g_maxSize &&
+				b.max.x < g_maxSize && b.max.y < g_maxSize
+			;
+		}
+
+		void update()
+		{
+			// Swap into a local, in case computing a bound causes
+			// further render requests.
+			std::unordered_set<const Gadget *> dirty;
+			dirty.swap( m_dirty );
+			for( const Gadget *gadget : dirty )
+			{
+				auto it = m_entries.find( gadget );
+				if( it == m_entries.end() )
+				{
+					continue;
+				}
+				Entry *entry = it->second.get();
+				removeFromCell( entry );
+				const Box3f b = gadget->transformedBound();
+				entry->bound = b.isEmpty() ? Box2f() : Box2f( V2f( b.min.x, b.min.y ), V2f( b.max.x, b.max.y ) );
+				insert( entry );
+			}
+		}
+
+		void insert( Entry *entry )
+		{
+			if( !isFinite( entry->bound ) )
+			{
+				m_unbounded.push_back( entry );
+				entry->cell = nullptr;
+				return;
+			}
+
+			// Grow the root until it contains the entry, adding the old root
+			// as one of the quadrants of the new one.
+			while( !boxContains( m_root->bound, entry->bound ) )
+			{
+				const Box2f &b = m_root->bound;
+				const V2f size = b.size();
+				Box2f newBound = b;
+				int quadrant = 0;
+				if( entry->bound.min.x < b.min.x )
+				{
+					newBound.min.x -= size.x;
+					quadrant |= 1;
+				}
+				else
+				{
+					newBound.max.x += size.x;
+				}
+				if( entry->bound.min.y < b.min.y )
+				{
+					newBound.min.y -= size.y;
+					quadrant |= 2;
+				}
+				else
+				{
+					newBound.max.y += size.y;
+				}
+
+				std::unique_ptr<Cell> newRoot( new Cell( newBound, nullptr ) );
+				m_root->parent = newRoot.get();
+				newRoot->children[quadrant] = std::move( m_root );
+				m_root = std::move( newRoot );
+			}
+
+			// Descend to the smallest cell which contains the entry.
+			Cell *cell = m_root.get();
+			for( int depth = 0; depth < g_maxDepth; ++depth )
+			{
+				const V2f c = cell->bound.center();
+				int quadrant = 0;
+				if( entry->bound.min.x >= c.x )
+				{
+					quadrant |= 1;
+				}
+				else if( entry->bound.max.x > c.x )
+				{
+					break;
+				}
+				if( entry->bound.min.y >= c.y )
+				{
+					quadrant |= 2;
+				}
+				else if( entry->bound.max.y > c.y )
+				{
+					break;
+				}
+
+				std::unique_ptr<Cell> &child = cell->children[quadrant];
+				if( !child )
+				{
+					child.reset( new Cell( cell->childBound( quadrant ), cell ) );
+				}
+				cell = child.get();
+			}
+
+			cell->entries.push_back( entry );
+			entry->cell = cell;
+		}
+
+		void removeFromCell( Entry *entry )
+		{
+			std::vector<Entry *> &entries = entry->cell ? entry->cell->entries : m_unbounded;
+			auto it = std::find( entries.begin(), entries.end(), entry );
+			if( it != entries.end() )
+			{
+				*it = entries.back();
+				entries.pop_back();
+			}
+
+			// Prune cells which are no longer needed.
+			Cell *cell = entry->cell;
+			entry->cell = nullptr;
+			while( cell && cell->parent && cell->empty() )
+			{
+				Cell *parent = cell->parent;
+				for( auto &child : parent->children )
+				{
+					if( child.get() == cell )
+					{
+						child.reset();
+					}
+				}
+				cell = parent;
+			}
+		}
+
+		template<typename Predicate>
+		void query( const Cell *cell, const Box2f &region, Predicate &predicate ) const
+		{
+			if( !cell->bound.intersects( region ) )
+			{
+				return;
+			}
+
+			for( const Entry *entry : cell->entries )
+			{
+				if( entry->bound.intersects( region ) )
+				{
+					predicate( entry->gadget );
+				}
+			}
+
+			for( const auto &child : cell->children )
+			{
+				if( child )
+				{
+					query( child.get(), region, predicate );
+				}
+			}
+		}
+
+		std::unique_ptr<Cell> m_root;
+		std::vector<Entry *> m_unbounded;
+		std::unordered_map<const Gadget *, EntryPtr> m_entries;
+		std::unordered_set<const Gadget *> m_dirty;
+
+		size_t m_visibilityEpoch;
+		bool m_cullingEnabled;
+
+};
+
 //////////////////////////////////////////////////////////////////////////
 // GraphGadget implementation
 //////////////////////////////////////////////////////////////////////////
@@ -120,7 +493,7 @@ struct CompareV2fX{
 IE_CORE_DEFINERUNTIMETYPED( GraphGadget );
 
 GraphGadget::GraphGadget( Gaffer::NodePtr root, Gaffer::SetPtr filter )
-	:	m_dragStartPosition( 0 ), m_lastDragPosition( 0 ), m_dragMode( None ), m_dragReconnectCandidate( nullptr ), m_dragReconnectSrcNodule( nullptr ), m_dragReconnectDstNodule( nullptr )
+	:	m_spatialIndex( new SpatialIndex ), m_dragStartPosition( 0 ), m_lastDragPosition( 0 ), m_dragMode( None ), m_dragReconnectCandidate( nullptr ), m_dragReconnectSrcNodule( nullptr ), m_dragReconnectDstNodule( nullptr )
 {
 	keyPressSignal().connect( boost::bind( &GraphGadget::keyPressed, this, ::_1,  ::_2 ) );
 	buttonPressSignal().connect( boost::bind( &GraphGadget::buttonPress, this, ::_1,  ::_2 ) );
@@ -611,6 +984,20 @@ ConnectionGadget *GraphGadget::connectionGadgetAt( const IECore::LineSegment3f &
 	return connectionGadget;
 }
 
+size_t GraphGadget::nodeGadgetsIntersecting( const Imath::Box2f &regionInGadgetSpace, std::vector<NodeGadget *> &nodeGadgets ) const
+{
+	m_spatialIndex->query(
+		regionInGadgetSpace,
+		[&nodeGadgets]( Gadget *gadget ) {
+			if( NodeGadget *nodeGadget = runTimeCast<NodeGadget>( gadget ) )
+			{
+				nodeGadgets.push_back( nodeGadget );
+			}
+		}
+	);
+	return nodeGadgets.size();
+}
+
 ConnectionGadget *GraphGadget::reconnectionGadgetAt( const NodeGadget *gadget, const IECore::LineSegment3f &lineInGadgetSpace ) const
 {
 	std::vector<GadgetPtr> gadgetsUnderMouse;
@@ -619,19 +1006,29 @@ ConnectionGadget *GraphGadget::reconnectionGadgetAt( const NodeGadget *gadget, c
 	const Imath::V3f corner0 = center - Imath::V3f( 2, 2, 1 );
 	const Imath::V3f corner1 = center + Imath::V3f( 2, 2, 1 );
 
+	// Use the spatial index to find candidate connections, so
+	// we don't need to render every connection in the graph.
+	std::vector<ConnectionGadget *> connections;
+	m_spatialIndex->query(
+		Box2f( V2f( corner0.x, corner0.y ) - V2f( g_connectionMargin ), V2f( corner1.x, corner1.y ) + V2f( g_connectionMargin ) ),
+		[&connections]( Gadget *g ) {
+			if( ConnectionGadget *c = runTimeCast<ConnectionGadget>( g ) )
+			{
+				connections.push_back( c );
+			}
+		}
+	);
+
 	std::vector<IECoreGL::HitRecord> selection;
 	{
 		ViewportGadget::SelectionScope selectionScope( corner0, corner1, this, selection, IECoreGL::Selector::IDRender );
 
-		for ( ChildContainer::const_iterator it = children().begin(); it != children().end(); ++it )
+		for( ConnectionGadget *c : connections )
 		{
-			if ( ConnectionGadget *c = IECore::runTimeCast<ConnectionGadget>( it->get() ) )
+			// don't consider the node's own connections, or connections without a source nodule
+			if ( c->srcNodule() && gadget->node() != c->srcNodule()->plug()->node() && gadget->node() != c->dstNodule()->plug()->node() )
 			{
-				// don't consider the node's own connections, or connections without a source nodule
-				if ( c->srcNodule() && gadget->node() != c->srcNodule()->plug()->node() && gadget->node() != c->dstNodule()->plug()->node() )
-				{
-					c->render();
-				}
+				c->render();
 			}
 		}
 	}
@@ -652,6 +1049,10 @@ void GraphGadget::doRenderLayer( Layer layer, const Style *style ) const
 {
 	Gadget::doRenderLayer( layer, style );
 
+	// Determine which children are visible, so that
+	// shouldRenderChild() can cull the rest.
+	m_spatialIndex->cull( visibleRegion() );
+
 	glDisable( GL_DEPTH_TEST );
 
 	switch( layer )
@@ -707,6 +1108,11 @@ void GraphGadget::doRenderLayer( Layer layer, const Style *style ) const
 
 }
 
+bool GraphGadget::shouldRenderChild( const Gadget *child ) const
+{
+	return m_spatialIndex->visible( child );
+}
+
 bool GraphGadget::keyPressed( GadgetPtr gadget, const KeyEvent &event )
 {
 	if( event.key == "D" )
@@ -895,6 +1301,18 @@ void GraphGadget::nodeMetadataChanged( IECore::TypeId nodeTypeId, IECore::Intern
 	}
 }
 
+void GraphGadget::nodeGadgetRenderRequested( Gadget *gadget )
+{
+	// The bounds of connections depend on the positions of the
+	// nodes at either end, so must be updated along with the node.
+	std::vector<ConnectionGadget *> connections;
+	connectionGadgets( static_cast<NodeGadget *>( gadget )->node(), connections );
+	for( ConnectionGadget *connection : connections )
+	{
+		m_spatialIndex->dirty( connection );
+	}
+}
+
 bool GraphGadget::buttonRelease( GadgetPtr gadget, const ButtonEvent &event )
 {
 	return true;
@@ -1026,6 +1444,7 @@ IECore::RunTimeTypedPtr GraphGadget::dragBegin( GadgetPtr gadget, const DragDrop
 		else if( !nodeGadget )
 		{
 			m_dragMode = Selecting;
+			m_dragSelectionBound = Box2f();
 			return IECore::NullObject::defaultNullObject();
 		}
 	}
@@ -1455,9 +1874,18 @@ void GraphGadget::updateDragSelection( bool dragEnd, ModifiableEvent::Modifiers
 	selectionBound.extendBy( m_dragStartPosition );
 	selectionBound.extendBy( m_lastDragPosition );
 
-	for( NodeGadgetMap::const_iterator it = m_nodeGadgets.begin(), eIt = m_nodeGadgets.end(); it != eIt; ++it )
+	// Nodes outside both the current and the previous selection bound
+	// can't have been affected by the drag, so we only need to visit
+	// the nodes within them.
+	Box2f region = selectionBound;
+	region.extendBy( m_dragSelectionBound );
+	m_dragSelectionBound = selectionBound;
+
+	std::vector<NodeGadget *> nodeGadgets;
+	nodeGadgetsIntersecting( region, nodeGadgets );
+
+	for( NodeGadget *nodeGadget : nodeGadgets )
 	{
-		NodeGadget *nodeGadget = it->second.gadget;
 		const Box3f nodeBound3 = nodeGadget->transformedBound();
 		const Box2f nodeBound2( V2f( nodeBound3.min.x, nodeBound3.min.y ), V2f( nodeBound3.max.x, nodeBound3.max.y ) );
 		if( boxContains( selectionBound, nodeBound2 ) )
@@ -1473,16 +1901,16 @@ void GraphGadget::updateDragSelection( bool dragEnd, ModifiableEvent::Modifiers
 
 			if( removeFromSelection )
 			{
-				m_scriptNode->selection()->remove( const_cast<Gaffer::Node *>( it->first ) );
+				m_scriptNode->selection()->remove( nodeGadget->node() );
 			}
 			else
 			{
-				m_scriptNode->selection()->add( const_cast<Gaffer::Node *>( it->first ) );
+				m_scriptNode->selection()->add( nodeGadget->node() );
 			}
 		}
 		else
 		{
-			nodeGadget->setHighlighted( m_scriptNode->selection()->contains( it->first ) );
+			nodeGadget->setHighlighted( m_scriptNode->selection()->contains( nodeGadget->node() ) );
 		}
 	}
 }
@@ -1531,12 +1959,14 @@ NodeGadget *GraphGadget::addNodeGadget( Gaffer::Node *node )
 	}
 
 	addChild( nodeGadget );
+	m_spatialIndex->add( nodeGadget.get() );
 
 	NodeGadgetEntry &nodeGadgetEntry = m_nodeGadgets[node];
 	nodeGadgetEntry.inputChangedConnection = node->plugInputChangedSignal().connect( boost::bind( &GraphGadget::inputChanged, this, ::_1 ) );
 	nodeGadgetEntry.plugSetConnection = node->plugSetSignal().connect( boost::bind( &GraphGadget::plugSet, this, ::_1 ) );
 	nodeGadgetEntry.noduleAddedConnection = nodeGadget->noduleAddedSignal().connect( boost::bind( &GraphGadget::noduleAdded, this, ::_2 ) );
 	nodeGadgetEntry.noduleRemovedConnection = nodeGadget->noduleRemovedSignal().connect( boost::bind( &GraphGadget::noduleRemoved, this, ::_2 ) );
+	nodeGadgetEntry.renderRequestConnection = nodeGadget->renderRequestSignal().connect( boost::bind( &GraphGadget::nodeGadgetRenderRequested, this, ::_1 ) );
 	nodeGadgetEntry.gadget = nodeGadget.get();
 
 	// highlight to reflect selection status
@@ -1556,6 +1986,7 @@ void GraphGadget::removeNodeGadget( const Gaffer::Node *node )
 	if( it!=m_nodeGadgets.end() )
 	{
 		removeConnectionGadgets( it->second.gadget );
+		m_spatialIndex->remove( it->second.gadget );
 		removeChild( it->second.gadget );
 		m_nodeGadgets.erase( it );
 	}
@@ -1618,6 +2049,7 @@ void GraphGadget::addConnectionGadgets( Nodule *nodule )
 			{
 				assert( connection->dstNodule()->plug()->getInput<Gaffer::Plug>() == nodule->plug() );
 				connection->setNodules( nodule, connection->dstNodule() );
+				m_spatialIndex->dirty( connection );
 			}
 		}
 	}
@@ -1646,6 +2078,7 @@ void GraphGadget::addConnectionGadget( Nodule *dstNodule )
 	ConnectionGadgetPtr connection = ConnectionGadget::create( srcNodule, dstNodule );
 	updateConnectionGadgetMinimisation( connection.get() );
 	addChild( connection );
+	m_spatialIndex->add( connection.get() );
 
 	m_connectionGadgets[dstNodule] = connection.get();
 }
@@ -1674,6 +2107,7 @@ void GraphGadget::removeConnectionGadgets( const Nodule *nodule )
 				if( connection->srcNodule() == nodule )
 				{
 					connection->setNodules( nullptr, connection->dstNodule() );
+					m_spatialIndex->dirty( connection );
 				}
 			}
 		}
@@ -1688,6 +2122,7 @@ void GraphGadget::removeConnectionGadget( const Nodule *dstNodule )
 		return;
 	}
 
+	m_spatialIndex->remove( it->second );
 	removeChild( it->second );
 	m_connectionGadgets.erase( it );
 }
@@ -65,7 +65,12 @@ IECORE_POP_DEFAULT_VISIBILITY
 
 #include "boost/graph/adjacency_list.hpp"
 
+#include "tbb/blocked_range.h"
+#include "tbb/parallel_for.h"
+
 #include <cassert>
+#include <limits>
+#include <memory>
 
 using namespace std;
 using namespace Imath;
@@ -194,6 +199,7 @@ class LayoutEngine
 				m_nodeSeparation( 2.0f * nodeSeparationScale ),
 				m_springStiffness( 0.1 ),
 				m_maxIterations( 10000 ),
+				m_maxStalledIterations( 500 ),
 				m_constraintsIterations( 10 )
 		{
 
@@ -603,31 +609,77 @@ class LayoutEngine
 
 		void solve( bool withCollisions )
 		{
+			// Pinned vertices never move, so we only need to visit the
+			// unpinned ones and the edges connected to them. This keeps
+			// the cost of each iteration proportional to the number of
+			// nodes being laid out rather than to the size of the graph.
+
+			CollisionVertices movable;
+			CollisionVertices pinned;
+			size_t index = 0;
 			VertexIteratorRange v = vertices( m_graph );
+			for( VertexIterator it = v.first; it != v.second; ++it, ++index )
+			{
+				if( m_graph[*it].pinned )
+				{
+					pinned.vertices.push_back( *it );
+					pinned.indices.push_back( index );
+				}
+				else
+				{
+					movable.vertices.push_back( *it );
+					movable.indices.push_back( index );
+				}
+			}
+
+			if( movable.vertices.empty() )
+			{
+				return;
+			}
+
+			vector<EdgeDescriptor> springs;
+			EdgeIteratorRange e = edges( m_graph );
+			for( EdgeIterator it = e.first; it != e.second; ++it )
+			{
+				if( !m_graph[source( *it, m_graph )].pinned || !m_graph[target( *it, m_graph )].pinned )
+				{
+					springs.push_back( *it );
+				}
+			}
+
+			// The bounds of the pinned vertices can be indexed
+			// once up front, and reused for every iteration.
+			if( withCollisions )
+			{
+				pinned.updateBounds( this );
+			}
 
 			size_t numConstraints = m_constraints.size();
+			float minMovement = std::numeric_limits<float>::max();
+			int stalledIterations = 0;
 			for( int i = 0; i < m_maxIterations; ++i )
 			{
-				for( VertexIterator it = v.first; it != v.second; ++it )
+				for( VertexDescriptor vd : movable.vertices )
 				{
-					Vertex &vt = m_graph[*it];
+					Vertex &vt = m_graph[vd];
 					vt.previousPosition = vt.position;
 				}
 
-				applySprings();
+				applySprings( movable.vertices, springs );
 				applyConstraints( m_constraintsIterations );
 
 				if( withCollisions )
 				{
-					addCollisionConstraints();
+					movable.updateBounds( this );
+					addCollisionConstraints( movable, pinned );
 					applyConstraints( m_constraintsIterations );
 					m_constraints.resize( numConstraints );
 				}
 
 				float maxMovement = 0;
-				for( VertexIterator it = v.first; it != v.second; ++it )
+				for( VertexDescriptor vd : movable.vertices )
 				{
-					const Vertex &vt = m_graph[*it];
+					const Vertex &vt = m_graph[vd];
 					maxMovement = max( maxMovement, fabs( vt.position.x - vt.previousPosition.x ) );
 					maxMovement = max( maxMovement, fabs( vt.position.y - vt.previousPosition.y ) );
 				}
@@ -636,6 +688,19 @@ class LayoutEngine
 				{
 					break;
 				}
+
+				// If the movement hasn't reduced for a while, then the
+				// constraints are in conflict and we're oscillating rather
+				// than converging. Further iterations won't improve matters.
+				if( maxMovement < minMovement )
+				{
+					minMovement = maxMovement;
+					stalledIterations = 0;
+				}
+				else if( ++stalledIterations >= m_maxStalledIterations )
+				{
+					break;
+				}
 			}
 		}
 
@@ -809,87 +874,151 @@ class LayoutEngine
 			);
 		}
 
-		void addCollisionConstraints()
+		// The vertices considered by addCollisionConstraints(), along with
+		// their padded bounds and an index for making fast intersection
+		// queries.
+		struct CollisionVertices
 		{
-			// build a tree for making fast bound intersection queries
-
-			vector<VertexDescriptor> vertexDescriptors;
+			vector<VertexDescriptor> vertices;
+			// Order of each vertex within the graph, used to
+			// consider each colliding pair in a consistent order.
+			vector<size_t> indices;
 			vector<Box2f> bounds;
+			std::unique_ptr<Box2fTree> tree;
 
-			const V2f padding( m_nodeSeparation / 2.0f );
-
-			VertexIteratorRange v = vertices( m_graph );
-			for( VertexIterator it = v.first; it != v.second; ++it )
+			void updateBounds( const LayoutEngine *engine )
 			{
-				V2f nodePadding( padding );
-				if( m_graph[*it].auxiliary )
+				bounds.clear();
+				for( VertexDescriptor v : vertices )
 				{
-					nodePadding *= 0.5;
+					bounds.push_back( engine->collisionBound( v ) );
 				}
-
-				Box2f b = m_graph[*it].bound;
-				b.min = b.min + m_graph[*it].position - nodePadding;
-				b.max = b.max + m_graph[*it].position + nodePadding;
-				bounds.push_back( b );
-				vertexDescriptors.push_back( *it );
+				tree.reset( bounds.empty() ? nullptr : new Box2fTree( bounds.begin(), bounds.end() ) );
 			}
+		};
 
-			Box2fTree tree( bounds.begin(), bounds.end() );
+		Box2f collisionBound( VertexDescriptor vertex ) const
+		{
+			const Vertex &v = m_graph[vertex];
+			V2f padding( m_nodeSeparation / 2.0f );
+			if( v.auxiliary )
+			{
+				padding *= 0.5;
+			}
 
-			// find colliding bounds, and add constraints to separate them
+			return Box2f(
+				v.bound.min + v.position - padding,
+				v.bound.max + v.position + padding
+			);
+		}
 
+		// Adds constraints to separate colliding movable vertices, both from
+		// each other and from the pinned vertices. Collisions between pinned
+		// vertices are not considered, since we couldn't resolve them anyway.
+		void addCollisionConstraints( const CollisionVertices &movable, const CollisionVertices &pinned )
+		{
 			typedef vector<Box2f>::const_iterator BoundIterator;
-			vector<BoundIterator> intersectingBounds;
-			for( BoundIterator it = bounds.begin(), eIt = bounds.end(); it != eIt; ++it )
+
+			// Find the colliding bounds in parallel, storing the results per
+			// vertex so that we can add the constraints in a deterministic order.
+			// This is ordered by movable vertex, with collisions against other
+			// movable vertices before those against pinned vertices, so it
+			// differs from the order in which all pairs were considered before
+			// pinned vertices were separated out.
+
+			vector<vector<size_t>> movableCollisions( movable.vertices.size() );
+			vector<vector<size_t>> pinnedCollisions( movable.vertices.size() );
+
+			tbb::parallel_for(
+				tbb::blocked_range<size_t>( 0, movable.vertices.size(), 64 ),
+				[&]( const tbb::blocked_range<size_t> &range ) {
+					vector<BoundIterator> intersectingBounds;
+					for( size_t i = range.begin(); i != range.end(); ++i )
+					{
+						intersectingBounds.clear();
+						movable.tree->intersectingBounds( movable.bounds[i], intersectingBounds );
+						for( const BoundIterator &b : intersectingBounds )
+						{
+							const size_t j = b - movable.bounds.begin();
+							if( j > i )
+							{
+								movableCollisions[i].push_back( j );
+							}
+						}
+
+						if( !pinned.tree )
+						{
+							continue;
+						}
+
+						intersectingBounds.clear();
+						pinned.tree->intersectingBounds( movable.bounds[i], intersectingBounds );
+						for( const BoundIterator &b : intersectingBounds )
+						{
+							pinnedCollisions[i].push_back( b - pinned.bounds.begin() );
+						}
+					}
+				}
+			);
+
+			for( size_t i = 0, e = movable.vertices.size(); i < e; ++i )
 			{
-				intersectingBounds.clear();
-				tree.intersectingBounds( *it, intersectingBounds );
-				for( vector<BoundIterator>::const_iterator bIt = intersectingBounds.begin(); bIt != intersectingBounds.end(); ++bIt )
+				for( size_t j : movableCollisions[i] )
 				{
-					size_t bound1Index = it - bounds.begin();
-					size_t bound2Index = *bIt - bounds.begin();
-					if( bound2Index <= bound1Index )
+					addCollisionConstraint( movable, i, movable, j );
+				}
+				for( size_t j : pinnedCollisions[i] )
+				{
+					if( pinned.indices[j] < movable.indices[i] )
 					{
-						// we dealt with this collision already, when bound2Index was bound1Index
-						continue;
+						addCollisionConstraint( pinned, j, movable, i );
 					}
-
-					Vertex &vertex1 = m_graph[vertexDescriptors[bound1Index]];
-					Vertex &vertex2 = m_graph[vertexDescriptors[bound2Index]];
-
-					if(
-						vertex1.collisionGroup < 0 ||
-						vertex2.collisionGroup < 0 ||
-						vertex1.collisionGroup != vertex2.collisionGroup
-					)
+					else
 					{
-						continue;
+						addCollisionConstraint( movable, i, pinned, j );
 					}
+				}
+			}
+		}
 
-					const Box2f &bound1 = *it;
-					const Box2f &bound2 = **bIt;
+		void addCollisionConstraint( const CollisionVertices &vertices1, size_t index1, const CollisionVertices &vertices2, size_t index2 )
+		{
+			const VertexDescriptor vertexDescriptor1 = vertices1.vertices[index1];
+			const VertexDescriptor vertexDescriptor2 = vertices2.vertices[index2];
+			Vertex &vertex1 = m_graph[vertexDescriptor1];
+			Vertex &vertex2 = m_graph[vertexDescriptor2];
 
-					const int a = collisionSeparationAxis( vertexDescriptors[bound1Index], vertexDescriptors[bound2Index] );
-					const V2f v = a == 0 ? V2f( 1, 0 ) : V2f( 0, 1 );
+			if(
+				vertex1.collisionGroup < 0 ||
+				vertex2.collisionGroup < 0 ||
+				vertex1.collisionGroup != vertex2.collisionGroup
+			)
+			{
+				return;
+			}
 
-					float separation = 0.5 * ( bound1.size()[a] + bound2.size()[a] );
-					Vertex *p = &vertex2;
-					Vertex *q = &vertex1;
-					if( vertex1.position[a] > vertex2.position[a] )
-					{
-						p = &vertex1;
-						q = &vertex2;
-					}
+			const Box2f &bound1 = vertices1.bounds[index1];
+			const Box2f &bound2 = vertices2.bounds[index2];
 
-					addConstraint(
-						*p,
-						*q,
-						Constraint::GreaterThanOrEqualTo,
-						separation,
-						v
-					);
-				}
+			const int a = collisionSeparationAxis( vertexDescriptor1, vertexDescriptor2 );
+			const V2f v = a == 0 ? V2f( 1, 0 ) : V2f( 0, 1 );
+
+			float separation = 0.5 * ( bound1.size()[a] + bound2.size()[a] );
+			Vertex *p = &vertex2;
+			Vertex *q = &vertex1;
+			if( vertex1.position[a] > vertex2.position[a] )
+			{
+				p = &vertex1;
+				q = &vertex2;
 			}
+
+			addConstraint(
+				*p,
+				*q,
+				Constraint::GreaterThanOrEqualTo,
+				separation,
+				v
+			);
 		}
 
 		int collisionSeparationAxis( VertexDescriptor vertex1, VertexDescriptor vertex2 )
@@ -954,16 +1083,18 @@ class LayoutEngine
 		// being separated by the vector (srcTangent - dstTangent).
 		// This is equivalent to applying a spring separately in the
 		// x and y directions.
-		void applySprings()
+		//
+		// Only the specified vertices and edges are considered -
+		// it is expected that these will exclude any that are
+		// entirely pinned.
+		void applySprings( const vector<VertexDescriptor> &movableVertices, const vector<EdgeDescriptor> &springs )
 		{
-			VertexIteratorRange v = vertices( m_graph );
-			for( VertexIterator it = v.first; it != v.second; ++it )
+			for( VertexDescriptor v : movableVertices )
 			{
-				m_graph[*it].force = V2f( 0.0f );
+				m_graph[v].force = V2f( 0.0f );
 			}
 
-			EdgeIteratorRange e = edges( m_graph );
-			for( EdgeIterator it = e.first; it != e.second; ++it )
+			for( vector<EdgeDescriptor>::const_iterator it = springs.begin(), eIt = springs.end(); it != eIt; ++it )
 			{
 				Vertex &src = m_graph[source( *it, m_graph )];
 				Vertex &dst = m_graph[target( *it, m_graph )];
@@ -995,9 +1126,9 @@ class LayoutEngine
 				dst.force += v * m_springStiffness * ( 1.0f - w );
 			}
 
-			for( VertexIterator it = v.first; it != v.second; ++it )
+			for( VertexDescriptor v : movableVertices )
 			{
-				m_graph[*it].position += m_graph[*it].force;
+				m_graph[v].position += m_graph[v].force;
 			}
 		}
 
@@ -1127,6 +1258,7 @@ class LayoutEngine
 		const float m_nodeSeparation;
 		const float m_springStiffness;
 		const int m_maxIterations;
+		const int m_maxStalledIterations;
 		const int m_constraintsIterations;
 
 };
@@ -161,6 +161,19 @@ list unpositionedNodeGadgets( GraphGadget &graphGadget )
 	return l;
 }
 
+list nodeGadgetsIntersecting( GraphGadget &graphGadget, const Imath::Box2f &region )
+{
+	std::vector<NodeGadget *> nodeGadgets;
+	graphGadget.nodeGadgetsIntersecting( region, nodeGadgets );
+
+	boost::python::list l;
+	for( std::vector<NodeGadget *>::const_iterator it=nodeGadgets.begin(), eIt=nodeGadgets.end(); it!=eIt; ++it )
+	{
+		l.append( NodeGadgetPtr( *it ) );
+	}
+	return l;
+}
+
 void setNodePosition( GraphGadget &graphGadget, Gaffer::Node &node, const Imath::V2f &position )
 {
 	IECorePython::ScopedGILRelease gilRelease;
@@ -247,6 +260,7 @@ void GafferUIModule::bindGraphGadget()
 			.def( "getLayout", (GraphLayout *(GraphGadget::*)())&GraphGadget::getLayout, return_value_policy<CastToIntrusivePtr>() )
 			.def( "nodeGadgetAt", &GraphGadget::nodeGadgetAt, return_value_policy<CastToIntrusivePtr>() )
 			.def( "connectionGadgetAt", &GraphGadget::connectionGadgetAt, return_value_policy<CastToIntrusivePtr>() )
+			.def( "nodeGadgetsIntersecting", &nodeGadgetsIntersecting )
 		;
 
 		GafferBindings::SignalClass<GraphGadget::RootChangedSignal, GafferBindings::DefaultSignalCaller<GraphGadget::RootChangedSignal>, RootChangedSlotCaller>( "RootChangedSignal" );
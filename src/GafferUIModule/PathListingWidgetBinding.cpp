@@ -55,6 +55,8 @@
 #include "boost/date_time/posix_time/conversion.hpp"
 #include "boost/python/suite/indexing/container_utils.hpp"
 
+#include <unordered_map>
+
 #include "QtCore/QAbstractItemModel"
 #include "QtCore/QDateTime"
 #include "QtCore/QModelIndex"
@@ -371,8 +373,13 @@ class PathModel : public QAbstractItemModel
 
 		void setColumns( const std::vector<ColumnPtr> columns )
 		{
+			// Force a rebuild of our items.
+			beginResetModel();
 			m_columns = columns;
-			setRoot( getRoot() ); // force a rebuild of our items
+			Gaffer::PathPtr root = m_rootItem->path();
+			delete m_rootItem;
+			m_rootItem = new Item( root, 0, nullptr );
+			endResetModel();
 		}
 
 		const std::vector<ColumnPtr> &getColumns() const
@@ -387,6 +394,19 @@ class PathModel : public QAbstractItemModel
 
 		void setRoot( PathPtr root )
 		{
+			const Path *oldRoot = m_rootItem->path();
+			if( root && oldRoot && root->names() == oldRoot->names() )
+			{
+				// The location is the same, but the contents may have
+				// changed (for instance because the scene has changed, or
+				// the filter has). Rather than resetting everything, we
+				// update our existing items, which preserves the expansion
+				// and selection in the view, and avoids fetching children
+				// which the view has no interest in.
+				m_rootItem->update( root, this, QModelIndex() );
+				return;
+			}
+
 			beginResetModel();
 			delete m_rootItem;
 			m_rootItem = new Item( root, 0, nullptr );
@@ -589,6 +609,137 @@ class PathModel : public QAbstractItemModel
 				}
 			}
 
+			// Updates the item to represent `path`, which must have the
+			// same names as the current path. Items for children which still
+			// exist are reused, and the model is notified of the rows which
+			// were removed or inserted, rather than being reset. Children
+			// which haven't been fetched yet are left to be fetched lazily.
+			// `index` is the model index for this item.
+			void update( Gaffer::PathPtr path, PathModel *model, const QModelIndex &index )
+			{
+				m_path = path;
+				m_dataDone = false;
+				m_displayData.clear();
+				m_decorationData.clear();
+
+				if( !m_childItemsDone )
+				{
+					return;
+				}
+
+				if( model->m_flat && index.isValid() )
+				{
+					// We have no rows in flat mode, so we can discard
+					// our children without notifying the view.
+					deleteChildItems();
+					return;
+				}
+
+				std::vector<Gaffer::PathPtr> children;
+				try
+				{
+					m_path->children( children );
+				}
+				catch( const std::exception &e )
+				{
+					IECore::msg( IECore::Msg::Error, "PathListingWidget", e.what() );
+				}
+
+				std::unordered_map<IECore::InternedString, Gaffer::PathPtr> childPaths;
+				for( const auto &child : children )
+				{
+					childPaths[child->names().back()] = child;
+				}
+
+				// Remove rows for children which no longer exist, in
+				// contiguous blocks, working backwards so that row
+				// numbers remain valid.
+
+				for( int last = (int)m_childItems.size() - 1; last >= 0; )
+				{
+					if( childPaths.count( m_childItems[last]->name() ) )
+					{
+						--last;
+						continue;
+					}
+
+					int first = last;
+					while( first > 0 && !childPaths.count( m_childItems[first-1]->name() ) )
+					{
+						--first;
+					}
+
+					model->beginRemoveRows( index, first, last );
+					for( int i = first; i <= last; ++i )
+					{
+						delete m_childItems[i];
+					}
+					m_childItems.erase( m_childItems.begin() + first, m_childItems.begin() + last + 1 );
+					model->endRemoveRows();
+
+					last = first - 1;
+				}
+
+				// Update the children which remain.
+
+				std::unordered_map<IECore::InternedString, Item *> childItems;
+				for( int i = 0, e = m_childItems.size(); i < e; ++i )
+				{
+					Item *childItem = m_childItems[i];
+					childItem->m_row = i;
+					childItems[childItem->name()] = childItem;
+					childItem->update( childPaths[childItem->name()], model, model->createIndex( i, 0, childItem ) );
+				}
+
+				// Append rows for new children.
+
+				std::vector<Item *> newItems;
+				for( const auto &child : children )
+				{
+					Item *&childItem = childItems[child->names().back()];
+					if( !childItem )
+					{
+						childItem = new Item( child, m_childItems.size() + newItems.size(), this );
+						newItems.push_back( childItem );
+					}
+				}
+
+				if( newItems.size() )
+				{
+					model->beginInsertRows( index, m_childItems.size(), m_childItems.size() + newItems.size() - 1 );
+					m_childItems.insert( m_childItems.end(), newItems.begin(), newItems.end() );
+					model->endInsertRows();
+				}
+
+				// Put everything in the right order, and let the
+				// view know that the data needs refreshing.
+
+				model->layoutAboutToBeChanged();
+				if( model->m_sortColumn >= 0 )
+				{
+					sort( model, /* recursive = */ false );
+				}
+				else
+				{
+					std::vector<Item *> order;
+					order.reserve( children.size() );
+					for( const auto &child : children )
+					{
+						order.push_back( childItems[child->names().back()] );
+					}
+					reorder( model, order );
+				}
+				model->layoutChanged();
+
+				if( m_childItems.size() )
+				{
+					model->dataChanged(
+						model->createIndex( 0, 0, m_childItems.front() ),
+						model->createIndex( m_childItems.size() - 1, model->columnCount() - 1, m_childItems.back() )
+					);
+				}
+			}
+
 			Gaffer::Path *path()
 			{
 				return m_path.get();
@@ -604,6 +755,11 @@ class PathModel : public QAbstractItemModel
 				return m_row;
 			}
 
+			const IECore::InternedString &name() const
+			{
+				return m_path->names().back();
+			}
+
 			// Returns the data for the specified column and role, using the provided
 			// Columns to generate it as necessary. The Item is responsible for caching
 			// the results of these queries internally.
@@ -650,7 +806,7 @@ class PathModel : public QAbstractItemModel
 				return m_childItems;
 			}
 
-			void sort( const PathModel *model )
+			void sort( const PathModel *model, bool recursive = true )
 			{
 				if( model->m_sortColumn < 0 || model->m_sortColumn >= model->columnCount() )
 				{
@@ -673,24 +829,20 @@ class PathModel : public QAbstractItemModel
 				std::sort( sortableChildren.begin(), sortableChildren.end(), Less( model->m_sortColumn ) );
 
 				const bool reverse = model->m_sortOrder == Qt::DescendingOrder;
-				QModelIndexList changedPersistentIndexesFrom, changedPersistentIndexesTo;
+				std::vector<Item *> order( sortableChildren.size() );
 				for( int i = 0, e = sortableChildren.size(); i < e; ++i )
 				{
-					int fromRow = sortableChildren[i].second;
-					int toRow = reverse ? e - i - 1 : i;
-					m_childItems[toRow] = sortableChildren[i].first;
-					for( int c = 0, ce = model->getColumns().size(); c < ce; ++c )
-					{
-						changedPersistentIndexesFrom.append( model->createIndex( fromRow, c, sortableChildren[i].first ) );
-						changedPersistentIndexesTo.append( model->createIndex( toRow, c, sortableChildren[i].first ) );
-					}
+					order[reverse ? e - i - 1 : i] = sortableChildren[i].first;
 				}
 
-				const_cast<PathModel *>( model )->changePersistentIndexList( changedPersistentIndexesFrom, changedPersistentIndexesTo );
+				reorder( model, order );
 
-				for( std::vector<Item *>::const_iterator it = m_childItems.begin(), eIt = m_childItems.end(); it != eIt; ++it )
+				if( recursive )
 				{
-					(*it)->sort( model );
+					for( std::vector<Item *>::const_iterator it = m_childItems.begin(), eIt = m_childItems.end(); it != eIt; ++it )
+					{
+						(*it)->sort( model );
+					}
 				}
 			}
 
@@ -699,6 +851,42 @@ class PathModel : public QAbstractItemModel
 				typedef std::pair<Item *, size_t> SortableItem;
 				typedef std::vector<SortableItem> SortableItems;
 
+				// Rearranges our children into `order`, which must contain
+				// the same items, updating any persistent indices to match.
+				// It is the caller's responsibility to emit the layout signals.
+				void reorder( const PathModel *model, const std::vector<Item *> &order )
+				{
+					QModelIndexList changedPersistentIndexesFrom, changedPersistentIndexesTo;
+					for( int toRow = 0, e = order.size(); toRow < e; ++toRow )
+					{
+						Item *item = order[toRow];
+						const int fromRow = item->m_row;
+						item->m_row = toRow;
+						m_childItems[toRow] = item;
+						if( fromRow == toRow )
+						{
+							continue;
+						}
+						for( int c = 0, ce = model->getColumns().size(); c < ce; ++c )
+						{
+							changedPersistentIndexesFrom.append( model->createIndex( fromRow, c, item ) );
+							changedPersistentIndexesTo.append( model->createIndex( toRow, c, item ) );
+						}
+					}
+
+					const_cast<PathModel *>( model )->changePersistentIndexList( changedPersistentIndexesFrom, changedPersistentIndexesTo );
+				}
+
+				void deleteChildItems()
+				{
+					for( std::vector<Item *>::const_iterator it = m_childItems.begin(), eIt = m_childItems.end(); it != eIt; ++it )
+					{
+						delete *it;
+					}
+					m_childItems.clear();
+					m_childItemsDone = false;
+				}
+
 				void ensureData( const std::vector<ColumnPtr> &columns )
 				{
 					if( m_dataDone )